@@ -12,9 +12,12 @@
 
 #include <config.h>
 #include "store-application.h"
+#include "store-trace.h"
 
 int main (int argc, char **argv)
 {
+    store_trace_init ();
+
     setlocale (LC_ALL, "");
 
     bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
@@ -22,5 +25,11 @@ int main (int argc, char **argv)
     textdomain (GETTEXT_PACKAGE);
 
     g_autoptr(StoreApplication) app = store_application_new ();
-    return g_application_run (G_APPLICATION (app), argc, argv);
+    int status = g_application_run (G_APPLICATION (app), argc, argv);
+
+    g_autoptr(GError) error = NULL;
+    if (!store_trace_write (&error))
+        g_warning ("Failed to write trace: %s", error->message);
+
+    return status;
 }
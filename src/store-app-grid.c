@@ -10,21 +10,48 @@
 #include "store-app-grid.h"
 
 #include "store-app-tile.h"
+#include "store-diff.h"
+#include "store-tile-reconciler.h"
+
+#define N_COLUMNS 3
+#define COLUMN_SPACING 20
+#define ROW_SPACING 20
+
+/* Number of rows above and below the visible area to keep tiles for */
+#define OVERSCAN_ROWS 2
+
+/* Height of the area to fill when not yet inside a scrolled window */
+#define DEFAULT_VISIBLE_HEIGHT 1000
+
+/* Number of tiles to make before the row height is known, the same as a page of apps from the model */
+#define INITIAL_N_TILES 30
 
 struct _StoreAppGrid
 {
-    GtkGrid parent_instance;
-
-    GtkGrid *app_grid;
+    GtkContainer parent_instance;
 
+    GListModel *app_list;
+    GListStore *app_store;
+    guint end_reached_n_apps;
+    GSource *end_reached_source;
     StoreModel *model;
+    StoreTileReconciler *reconciler;
+    gint row_height;
+    GtkScrolledWindow *scrolled_window;
+    GPtrArray *tiles;
+    GSource *tiles_source;
+    GtkAdjustment *vadjustment;
+    guint visible_end;
+    guint visible_start;
+    GPtrArray *visible_tiles;
 };
 
-G_DEFINE_TYPE (StoreAppGrid, store_app_grid, GTK_TYPE_GRID)
+G_DEFINE_TYPE (StoreAppGrid, store_app_grid, GTK_TYPE_CONTAINER)
 
 enum
 {
     SIGNAL_APP_ACTIVATED,
+    SIGNAL_END_REACHED,
     SIGNAL_LAST
 };
 
@@ -36,22 +63,367 @@ app_activated_cb (StoreAppGrid *self, StoreAppTile *tile)
     g_signal_emit (self, signals[SIGNAL_APP_ACTIVATED], 0, store_app_tile_get_app (tile));
 }
 
+static guint
+get_n_apps (StoreAppGrid *self)
+{
+    return self->app_list != NULL ? g_list_model_get_n_items (self->app_list) : 0;
+}
+
+static StoreAppTile *
+get_tile (StoreAppGrid *self, guint index)
+{
+    return g_ptr_array_index (self->visible_tiles, index - self->visible_start);
+}
+
+static GtkWidget *
+new_tile_cb (StoreAppGrid *self)
+{
+    StoreAppTile *tile = store_app_tile_new ();
+    gtk_widget_show (GTK_WIDGET (tile));
+    g_signal_connect_object (tile, "activated", G_CALLBACK (app_activated_cb), self, G_CONNECT_SWAPPED);
+    store_app_tile_set_model (tile, self->model);
+    return GTK_WIDGET (tile);
+}
+
+static gint
+get_column_width (gint width)
+{
+    return MAX ((width - COLUMN_SPACING * (N_COLUMNS - 1)) / N_COLUMNS, 0);
+}
+
+static void
+get_visible_range (StoreAppGrid *self, guint *start, guint *end)
+{
+    guint n_apps = get_n_apps (self);
+
+    /* Nothing has been measured before the first allocation */
+    if (self->row_height == 0) {
+        *start = 0;
+        *end = MIN (INITIAL_N_TILES, n_apps);
+        return;
+    }
+
+    /* Position of the visible area relative to the grid */
+    gint top = 0, bottom = DEFAULT_VISIBLE_HEIGHT;
+    if (self->scrolled_window != NULL && self->vadjustment != NULL) {
+        GtkWidget *viewport = gtk_bin_get_child (GTK_BIN (self->scrolled_window));
+        gint x, y;
+        if (viewport != NULL && gtk_widget_translate_coordinates (GTK_WIDGET (self), viewport, 0, 0, &x, &y)) {
+            top = -y;
+            bottom = -y + gtk_adjustment_get_page_size (self->vadjustment);
+        }
+    }
+
+    gint row_stride = self->row_height + ROW_SPACING;
+    gint first_row = MAX (top, 0) / row_stride - OVERSCAN_ROWS;
+    gint last_row = MAX (bottom, 0) / row_stride + 1 + OVERSCAN_ROWS;
+    *start = MIN ((guint) MAX (first_row, 0) * N_COLUMNS, n_apps);
+    *end = MIN ((guint) last_row * N_COLUMNS, n_apps);
+}
+
+static gboolean
+end_reached_cb (gpointer user_data)
+{
+    StoreAppGrid *self = user_data;
+
+    g_clear_pointer (&self->end_reached_source, g_source_unref);
+    g_signal_emit (self, signals[SIGNAL_END_REACHED], 0);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* Let the owner add more apps when the last ones come into view. This is done from idle as it is found during layout */
+static void
+check_end_reached (StoreAppGrid *self)
+{
+    guint n_apps = get_n_apps (self);
+    if (n_apps == 0 || self->row_height == 0 || self->visible_end < n_apps || self->end_reached_n_apps == n_apps || self->end_reached_source != NULL)
+        return;
+
+    self->end_reached_n_apps = n_apps;
+    self->end_reached_source = g_idle_source_new ();
+    g_source_set_callback (self->end_reached_source, end_reached_cb, self, NULL);
+    g_source_attach (self->end_reached_source, g_main_context_default ());
+}
+
+static gboolean
+tiles_equal (GPtrArray *a, GPtrArray *b)
+{
+    if (a->len != b->len)
+        return FALSE;
+    for (guint i = 0; i < a->len; i++)
+        if (g_ptr_array_index (a, i) != g_ptr_array_index (b, i))
+            return FALSE;
+    return TRUE;
+}
+
+/* Make tiles for the visible apps, keeping the tiles of apps still in view and reusing the ones that have scrolled out of view */
+static void
+update_visible_tiles (StoreAppGrid *self)
+{
+    guint start, end;
+    get_visible_range (self, &start, &end);
+
+    g_autoptr(GPtrArray) unused_tiles = g_ptr_array_new ();
+    g_autoptr(GPtrArray) visible_tiles = store_tile_reconciler_reconcile (self->reconciler, self->tiles, self->app_list, start, end, unused_tiles);
+
+    for (guint i = 0; i < visible_tiles->len; i++) {
+        GtkWidget *tile = g_ptr_array_index (visible_tiles, i);
+        if (gtk_widget_get_parent (tile) == NULL) {
+            gtk_widget_set_parent (tile, GTK_WIDGET (self));
+            g_ptr_array_add (self->tiles, tile);
+        }
+        gtk_widget_set_child_visible (tile, TRUE);
+    }
+
+    /* Keep the tiles not in use for when the view scrolls */
+    for (guint i = 0; i < unused_tiles->len; i++)
+        gtk_widget_set_child_visible (g_ptr_array_index (unused_tiles, i), FALSE);
+
+    gboolean changed = start != self->visible_start || !tiles_equal (visible_tiles, self->visible_tiles);
+    self->visible_start = start;
+    self->visible_end = end;
+    g_ptr_array_unref (self->visible_tiles);
+    self->visible_tiles = g_steal_pointer (&visible_tiles);
+    if (changed)
+        gtk_widget_queue_allocate (GTK_WIDGET (self));
+
+    check_end_reached (self);
+}
+
+static void
+items_changed_cb (StoreAppGrid *self, guint position, guint removed, guint added)
+{
+    guint n_apps = get_n_apps (self);
+    guint old_n_rows = (n_apps - added + removed + N_COLUMNS - 1) / N_COLUMNS;
+    guint n_rows = (n_apps + N_COLUMNS - 1) / N_COLUMNS;
+
+    /* Changes below the visible area don't move any tiles, and tiles only change if they now show a different app */
+    guint start, end;
+    get_visible_range (self, &start, &end);
+    if (position < end || start != self->visible_start || end != self->visible_end)
+        update_visible_tiles (self);
+
+    /* The grid only needs a new size if the number of rows has changed */
+    if (n_rows != old_n_rows)
+        gtk_widget_queue_resize (GTK_WIDGET (self));
+}
+
+static gboolean
+tiles_cb (gpointer user_data)
+{
+    StoreAppGrid *self = user_data;
+
+    g_clear_pointer (&self->tiles_source, g_source_unref);
+
+    guint start, end;
+    get_visible_range (self, &start, &end);
+    if (start != self->visible_start || end != self->visible_end)
+        update_visible_tiles (self);
+    else
+        check_end_reached (self);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* The visible area changes during layout, so tiles are added and removed afterwards.
+ * The overscan rows cover the frame drawn before then */
+static void
+adjustment_changed_cb (StoreAppGrid *self)
+{
+    if (self->tiles_source != NULL)
+        return;
+
+    self->tiles_source = g_idle_source_new ();
+    g_source_set_priority (self->tiles_source, G_PRIORITY_HIGH_IDLE);
+    g_source_set_callback (self->tiles_source, tiles_cb, self, NULL);
+    g_source_attach (self->tiles_source, g_main_context_default ());
+}
+
+static void
+set_vadjustment (StoreAppGrid *self, GtkAdjustment *vadjustment)
+{
+    if (self->vadjustment == vadjustment)
+        return;
+
+    if (self->vadjustment != NULL)
+        g_signal_handlers_disconnect_by_func (self->vadjustment, adjustment_changed_cb, self);
+    g_set_object (&self->vadjustment, vadjustment);
+    if (self->vadjustment != NULL) {
+        g_signal_connect_object (self->vadjustment, "value-changed", G_CALLBACK (adjustment_changed_cb), self, G_CONNECT_SWAPPED);
+        g_signal_connect_object (self->vadjustment, "changed", G_CALLBACK (adjustment_changed_cb), self, G_CONNECT_SWAPPED);
+    }
+}
+
+static void
+store_app_grid_hierarchy_changed (GtkWidget *widget, GtkWidget *previous_toplevel)
+{
+    StoreAppGrid *self = STORE_APP_GRID (widget);
+
+    if (GTK_WIDGET_CLASS (store_app_grid_parent_class)->hierarchy_changed != NULL)
+        GTK_WIDGET_CLASS (store_app_grid_parent_class)->hierarchy_changed (widget, previous_toplevel);
+
+    /* Only the part of the grid in view of the scrolled window needs tiles */
+    GtkWidget *scrolled_window = gtk_widget_get_ancestor (widget, GTK_TYPE_SCROLLED_WINDOW);
+    self->scrolled_window = scrolled_window != NULL ? GTK_SCROLLED_WINDOW (scrolled_window) : NULL;
+    set_vadjustment (self, self->scrolled_window != NULL ? gtk_scrolled_window_get_vadjustment (self->scrolled_window) : NULL);
+    update_visible_tiles (self);
+}
+
+/* Rows all have the same height, taken from the tallest tile seen so far */
+static void
+update_row_height (StoreAppGrid *self, gint column_width)
+{
+    for (guint i = self->visible_start; i < self->visible_end; i++) {
+        gint min_height, natural_height;
+        gtk_widget_get_preferred_height_for_width (GTK_WIDGET (get_tile (self, i)), column_width, &min_height, &natural_height);
+        self->row_height = MAX (self->row_height, natural_height);
+    }
+}
+
+static GtkSizeRequestMode
+store_app_grid_get_request_mode (GtkWidget *widget G_GNUC_UNUSED)
+{
+    return GTK_SIZE_REQUEST_HEIGHT_FOR_WIDTH;
+}
+
+static void
+store_app_grid_get_preferred_width (GtkWidget *widget, gint *minimum_width, gint *natural_width)
+{
+    StoreAppGrid *self = STORE_APP_GRID (widget);
+
+    gint tile_minimum_width = 0, tile_natural_width = 0;
+    for (guint i = self->visible_start; i < self->visible_end; i++) {
+        gint min_width, nat_width;
+        gtk_widget_get_preferred_width (GTK_WIDGET (get_tile (self, i)), &min_width, &nat_width);
+        tile_minimum_width = MAX (tile_minimum_width, min_width);
+        tile_natural_width = MAX (tile_natural_width, nat_width);
+    }
+
+    *minimum_width = tile_minimum_width * N_COLUMNS + COLUMN_SPACING * (N_COLUMNS - 1);
+    *natural_width = tile_natural_width * N_COLUMNS + COLUMN_SPACING * (N_COLUMNS - 1);
+}
+
+static void
+store_app_grid_get_preferred_height_for_width (GtkWidget *widget, gint width, gint *minimum_height, gint *natural_height)
+{
+    StoreAppGrid *self = STORE_APP_GRID (widget);
+
+    update_row_height (self, get_column_width (width));
+
+    guint n_rows = (get_n_apps (self) + N_COLUMNS - 1) / N_COLUMNS;
+    gint height = n_rows > 0 ? n_rows * self->row_height + (n_rows - 1) * ROW_SPACING : 0;
+    *minimum_height = *natural_height = height;
+}
+
+static void
+store_app_grid_get_preferred_height (GtkWidget *widget, gint *minimum_height, gint *natural_height)
+{
+    gint minimum_width, natural_width;
+    store_app_grid_get_preferred_width (widget, &minimum_width, &natural_width);
+    store_app_grid_get_preferred_height_for_width (widget, natural_width, minimum_height, natural_height);
+}
+
+static void
+store_app_grid_size_allocate (GtkWidget *widget, GtkAllocation *allocation)
+{
+    StoreAppGrid *self = STORE_APP_GRID (widget);
+
+    gtk_widget_set_allocation (widget, allocation);
+
+    gint column_width = get_column_width (allocation->width);
+    update_row_height (self, column_width);
+
+    for (guint i = self->visible_start; i < self->visible_end; i++) {
+        GtkWidget *tile = GTK_WIDGET (get_tile (self, i));
+
+        /* GTK requires children to be measured before being allocated */
+        gint min_width, min_height;
+        gtk_widget_get_preferred_width (tile, &min_width, NULL);
+        gtk_widget_get_preferred_height_for_width (tile, column_width, &min_height, NULL);
+
+        GtkAllocation child_allocation;
+        child_allocation.x = allocation->x + (i % N_COLUMNS) * (column_width + COLUMN_SPACING);
+        child_allocation.y = allocation->y + (i / N_COLUMNS) * (self->row_height + ROW_SPACING);
+        child_allocation.width = column_width;
+        child_allocation.height = self->row_height;
+        gtk_widget_size_allocate (tile, &child_allocation);
+    }
+
+    /* The visible area may have moved now the grid has been placed */
+    adjustment_changed_cb (self);
+}
+
+static void
+store_app_grid_forall (GtkContainer *container, gboolean include_internals G_GNUC_UNUSED, GtkCallback callback, gpointer callback_data)
+{
+    StoreAppGrid *self = STORE_APP_GRID (container);
+
+    /* Go backwards so the callback can remove tiles */
+    for (guint i = self->tiles->len; i > 0; i--)
+        callback (g_ptr_array_index (self->tiles, i - 1), callback_data);
+}
+
+static void
+store_app_grid_remove (GtkContainer *container, GtkWidget *widget)
+{
+    StoreAppGrid *self = STORE_APP_GRID (container);
+
+    if (!g_ptr_array_remove (self->tiles, widget))
+        return;
+    gtk_widget_unparent (widget);
+
+    /* Tiles are found again on the next update */
+    g_ptr_array_set_size (self->visible_tiles, 0);
+    self->visible_start = self->visible_end = 0;
+}
+
 static void
 store_app_grid_dispose (GObject *object)
 {
     StoreAppGrid *self = STORE_APP_GRID (object);
 
+    if (self->app_list != NULL)
+        g_signal_handlers_disconnect_by_func (self->app_list, items_changed_cb, self);
+    g_clear_object (&self->app_list);
+    g_clear_object (&self->app_store);
+    if (self->end_reached_source != NULL)
+        g_source_destroy (self->end_reached_source);
+    g_clear_pointer (&self->end_reached_source, g_source_unref);
     g_clear_object (&self->model);
+    g_clear_object (&self->reconciler);
+    if (self->tiles_source != NULL)
+        g_source_destroy (self->tiles_source);
+    g_clear_pointer (&self->tiles_source, g_source_unref);
+    set_vadjustment (self, NULL);
 
     G_OBJECT_CLASS (store_app_grid_parent_class)->dispose (object);
 }
 
+static void
+store_app_grid_finalize (GObject *object)
+{
+    StoreAppGrid *self = STORE_APP_GRID (object);
+
+    g_clear_pointer (&self->tiles, g_ptr_array_unref);
+    g_clear_pointer (&self->visible_tiles, g_ptr_array_unref);
+
+    G_OBJECT_CLASS (store_app_grid_parent_class)->finalize (object);
+}
+
 static void
 store_app_grid_class_init (StoreAppGridClass *klass)
 {
     G_OBJECT_CLASS (klass)->dispose = store_app_grid_dispose;
-
-    gtk_widget_class_set_template_from_resource (GTK_WIDGET_CLASS (klass), "/io/snapcraft/Store/store-app-grid.ui");
+    G_OBJECT_CLASS (klass)->finalize = store_app_grid_finalize;
+    GTK_WIDGET_CLASS (klass)->get_preferred_height = store_app_grid_get_preferred_height;
+    GTK_WIDGET_CLASS (klass)->get_preferred_height_for_width = store_app_grid_get_preferred_height_for_width;
+    GTK_WIDGET_CLASS (klass)->get_preferred_width = store_app_grid_get_preferred_width;
+    GTK_WIDGET_CLASS (klass)->get_request_mode = store_app_grid_get_request_mode;
+    GTK_WIDGET_CLASS (klass)->hierarchy_changed = store_app_grid_hierarchy_changed;
+    GTK_WIDGET_CLASS (klass)->size_allocate = store_app_grid_size_allocate;
+    GTK_CONTAINER_CLASS (klass)->forall = store_app_grid_forall;
+    GTK_CONTAINER_CLASS (klass)->remove = store_app_grid_remove;
 
     signals[SIGNAL_APP_ACTIVATED] = g_signal_new ("app-activated",
                                                   G_TYPE_FROM_CLASS (G_OBJECT_CLASS (klass)),
@@ -61,12 +433,29 @@ store_app_grid_class_init (StoreAppGridClass *klass)
                                                   NULL,
                                                   G_TYPE_NONE,
                                                   1, store_app_get_type ());
+
+    signals[SIGNAL_END_REACHED] = g_signal_new ("end-reached",
+                                                G_TYPE_FROM_CLASS (G_OBJECT_CLASS (klass)),
+                                                G_SIGNAL_RUN_LAST,
+                                                0,
+                                                NULL, NULL,
+                                                NULL,
+                                                G_TYPE_NONE,
+                                                0);
 }
 
 static void
 store_app_grid_init (StoreAppGrid *self)
 {
-    gtk_widget_init_template (GTK_WIDGET (self));
+    gtk_widget_set_has_window (GTK_WIDGET (self), FALSE);
+
+    self->app_store = g_list_store_new (store_app_get_type ());
+    self->reconciler = store_tile_reconciler_new ((StoreTileNewFunc) new_tile_cb,
+                                                  (StoreTileGetItemFunc) store_app_tile_get_app,
+                                                  (StoreTileSetItemFunc) store_app_tile_set_app,
+                                                  self);
+    self->tiles = g_ptr_array_new ();
+    self->visible_tiles = g_ptr_array_new ();
 }
 
 StoreAppGrid *
@@ -80,32 +469,31 @@ store_app_grid_set_apps (StoreAppGrid *self, GPtrArray *apps)
 {
     g_return_if_fail (STORE_IS_APP_GRID (self));
 
-    /* Ensure correct number of app tiles */
-    // FIXME: Make a new widget that does this
-    g_autoptr(GList) children = gtk_container_get_children (GTK_CONTAINER (self));
-    guint n_tiles = g_list_length (children);
-    while (n_tiles < apps->len) {
-        StoreAppTile *tile = store_app_tile_new ();
-        gtk_widget_show (GTK_WIDGET (tile));
-        g_signal_connect_object (tile, "activated", G_CALLBACK (app_activated_cb), self, G_CONNECT_SWAPPED);
-        store_app_tile_set_model (tile, self->model);
-        gtk_grid_attach (GTK_GRID (self), GTK_WIDGET (tile), n_tiles % 3, n_tiles / 3, 1, 1);
-        n_tiles++;
-    }
-    for (GList *link = children; link != NULL; link = link->next) {
-        GtkWidget *child = link->data;
-        int left_attach, top_attach;
-        gtk_container_child_get (GTK_CONTAINER (self), child, "left-attach", &left_attach, "top-attach", &top_attach, NULL);
-        guint index = top_attach * 3 + left_attach;
-        if (index >= apps->len)
-            gtk_container_remove (GTK_CONTAINER (self), child);
-    }
+    store_app_grid_set_app_list (self, G_LIST_MODEL (self->app_store));
 
-    for (guint i = 0; i < apps->len; i++) {
-        StoreApp *app = g_ptr_array_index (apps, i);
-        StoreAppTile *tile = STORE_APP_TILE (gtk_grid_get_child_at (GTK_GRID (self), i % 3, i / 3));
-        store_app_tile_set_app (tile, app);
-    }
+    /* Tiles are only updated if they now show a different app */
+    self->end_reached_n_apps = 0;
+    store_diff_update_list_store (self->app_store, apps);
+    check_end_reached (self);
+}
+
+void
+store_app_grid_set_app_list (StoreAppGrid *self, GListModel *apps)
+{
+    g_return_if_fail (STORE_IS_APP_GRID (self));
+
+    if (self->app_list == apps)
+        return;
+
+    if (self->app_list != NULL)
+        g_signal_handlers_disconnect_by_func (self->app_list, items_changed_cb, self);
+    g_set_object (&self->app_list, apps);
+    self->end_reached_n_apps = 0;
+    if (self->app_list != NULL)
+        g_signal_connect_object (self->app_list, "items-changed", G_CALLBACK (items_changed_cb), self, G_CONNECT_SWAPPED);
+
+    update_visible_tiles (self);
+    gtk_widget_queue_resize (GTK_WIDGET (self));
 }
 
 void
@@ -114,9 +502,6 @@ store_app_grid_set_model (StoreAppGrid *self, StoreModel *model)
     g_return_if_fail (STORE_IS_APP_GRID (self));
 
     g_set_object (&self->model, model);
-    g_autoptr(GList) children = gtk_container_get_children (GTK_CONTAINER (self));
-    for (GList *link = children; link != NULL; link = link->next) {
-        StoreAppTile *tile = link->data;
-        store_app_tile_set_model (tile, model);
-    }
+    for (guint i = 0; i < self->tiles->len; i++)
+        store_app_tile_set_model (g_ptr_array_index (self->tiles, i), model);
 }
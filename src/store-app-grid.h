@@ -16,12 +16,14 @@
 
 G_BEGIN_DECLS
 
-G_DECLARE_FINAL_TYPE (StoreAppGrid, store_app_grid, STORE, APP_GRID, GtkGrid)
+G_DECLARE_FINAL_TYPE (StoreAppGrid, store_app_grid, STORE, APP_GRID, GtkContainer)
 
-StoreAppGrid *store_app_grid_new       (void);
+StoreAppGrid *store_app_grid_new          (void);
 
-void          store_app_grid_set_apps  (StoreAppGrid *grid, GPtrArray *apps);
+void          store_app_grid_set_apps     (StoreAppGrid *grid, GPtrArray *apps);
 
-void          store_app_grid_set_model (StoreAppGrid *grid, StoreModel *model);
+void          store_app_grid_set_app_list (StoreAppGrid *grid, GListModel *apps);
+
+void          store_app_grid_set_model    (StoreAppGrid *grid, StoreModel *model);
 
 G_END_DECLS
@@ -27,6 +27,7 @@ struct _StoreAppInstalledTile
     GtkLabel *title_label;
 
     StoreApp *app;
+    GPtrArray *bindings;
 };
 
 G_DEFINE_TYPE (StoreAppInstalledTile, store_app_installed_tile, GTK_TYPE_EVENT_BOX)
@@ -88,6 +89,7 @@ store_app_installed_tile_dispose (GObject *object)
     StoreAppInstalledTile *self = STORE_APP_INSTALLED_TILE (object);
 
     g_clear_object (&self->app);
+    g_clear_pointer (&self->bindings, g_ptr_array_unref);
 
     G_OBJECT_CLASS (store_app_installed_tile_parent_class)->dispose (object);
 }
@@ -127,6 +129,8 @@ store_app_installed_tile_init (StoreAppInstalledTile *self)
     store_image_get_type ();
     store_rating_label_get_type ();
     gtk_widget_init_template (GTK_WIDGET (self));
+
+    self->bindings = g_ptr_array_new_with_free_func (g_object_unref);
 }
 
 StoreAppInstalledTile *
@@ -147,13 +151,21 @@ store_app_installed_tile_set_app (StoreAppInstalledTile *self, StoreApp *app)
     if (app != NULL)
         self->app = g_object_ref (app);
 
-    g_object_bind_property (app, "icon", self->icon_image, "media", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "publisher", self->publisher_label, "label", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "publisher-validated", self->publisher_validated_image, "visible", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "review-average", self->rating_label, "rating", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "summary", self->summary_label, "label", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "title", self->title_label, "label", G_BINDING_SYNC_CREATE);
-    g_object_bind_property_full (app, "installed-size", self->size_label, "label", G_BINDING_SYNC_CREATE, installed_size_to_label, NULL, NULL, NULL); // FIXME: Support download size for uninstalled snaps
+    /* Tiles are reused, so stop following the previous app */
+    for (guint i = 0; i < self->bindings->len; i++)
+        g_binding_unbind (g_ptr_array_index (self->bindings, i));
+    g_ptr_array_set_size (self->bindings, 0);
+
+    if (app == NULL)
+        return;
+
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "icon", self->icon_image, "media", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "publisher", self->publisher_label, "label", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "publisher-validated", self->publisher_validated_image, "visible", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "review-average", self->rating_label, "rating", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "summary", self->summary_label, "label", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "title", self->title_label, "label", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property_full (app, "installed-size", self->size_label, "label", G_BINDING_SYNC_CREATE, installed_size_to_label, NULL, NULL, NULL))); // FIXME: Support download size for uninstalled snaps
 }
 
 StoreApp *
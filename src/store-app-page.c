@@ -34,6 +34,7 @@ struct _StoreAppPage
     StoreImage *icon_image;
     GtkButton *install_button;
     GtkButton *launch_button;
+    GtkButton *more_reviews_button;
     GtkLabel *publisher_label;
     GtkImage *publisher_validated_image;
     StoreRatingLabel *rating_label;
@@ -163,6 +164,47 @@ launch_cb (StoreAppPage *self)
         g_warning ("Failed to launch app: %s", error->message); // FIXME: Show graphically
 }
 
+static void
+reviews_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    StoreAppPage *self = user_data;
+
+    g_autoptr(GError) error = NULL;
+    if (!store_model_update_reviews_finish (STORE_MODEL (object), result, &error)) {
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            return;
+        g_warning ("Failed to get reviews: %s", error->message);
+        return;
+    }
+
+    gtk_widget_set_visible (GTK_WIDGET (self->more_reviews_button), store_model_get_has_more_reviews (STORE_MODEL (object), self->app));
+}
+
+static void
+more_reviews_load_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    StoreAppPage *self = user_data;
+
+    g_autoptr(GError) error = NULL;
+    if (!store_model_load_more_reviews_finish (STORE_MODEL (object), result, &error)) {
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            return;
+        g_warning ("Failed to get more reviews: %s", error->message);
+        gtk_widget_set_sensitive (GTK_WIDGET (self->more_reviews_button), TRUE);
+        return;
+    }
+
+    gtk_widget_set_sensitive (GTK_WIDGET (self->more_reviews_button), TRUE);
+    gtk_widget_set_visible (GTK_WIDGET (self->more_reviews_button), store_model_get_has_more_reviews (STORE_MODEL (object), self->app));
+}
+
+static void
+more_reviews_cb (StoreAppPage *self)
+{
+    gtk_widget_set_sensitive (GTK_WIDGET (self->more_reviews_button), FALSE);
+    store_model_load_more_reviews_async (store_page_get_model (STORE_PAGE (self)), self->app, self->cancellable, more_reviews_load_cb, self);
+}
+
 static void
 remove_cb (StoreAppPage *self)
 {
@@ -240,6 +282,7 @@ store_app_page_class_init (StoreAppPageClass *klass)
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, icon_image);
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, install_button);
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, launch_button);
+    gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, more_reviews_button);
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, publisher_label);
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, publisher_validated_image);
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppPage, rating_label);
@@ -255,6 +298,7 @@ store_app_page_class_init (StoreAppPageClass *klass)
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), contact_link_cb);
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), install_cb);
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), launch_cb);
+    gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), more_reviews_cb);
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), remove_cb);
 }
 
@@ -280,6 +324,8 @@ store_app_page_set_app (StoreAppPage *self, StoreApp *app)
 
     g_set_object (&self->app, app);
 
+    store_model_load_details (store_page_get_model (STORE_PAGE (self)), app);
+
     g_cancellable_cancel (self->cancellable);
     self->cancellable = g_cancellable_new ();
     store_app_refresh_async (app, self->cancellable, refresh_cb, self);
@@ -325,8 +371,10 @@ store_app_page_set_app (StoreAppPage *self, StoreApp *app)
     g_object_bind_property (app, "installed", self->install_button, "visible", G_BINDING_SYNC_CREATE | G_BINDING_INVERT_BOOLEAN);
 
     gtk_widget_hide (GTK_WIDGET (self->reviews_box));
+    gtk_widget_hide (GTK_WIDGET (self->more_reviews_button));
+    gtk_widget_set_sensitive (GTK_WIDGET (self->more_reviews_button), TRUE);
 
-    store_model_update_reviews_async (store_page_get_model (STORE_PAGE (self)), app, self->cancellable, NULL, NULL);
+    store_model_update_reviews_async (store_page_get_model (STORE_PAGE (self)), app, self->cancellable, reviews_cb, self);
 
     store_screenshot_view_set_app (self->screenshot_view, app);
     GPtrArray *screenshots = store_app_get_screenshots (app);
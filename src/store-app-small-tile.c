@@ -19,6 +19,8 @@ struct _StoreAppSmallTile
     GtkLabel *title_label;
 
     StoreApp *app;
+    GPtrArray *bindings;
+    StoreModel *model;
 };
 
 G_DEFINE_TYPE (StoreAppSmallTile, store_app_small_tile, GTK_TYPE_EVENT_BOX)
@@ -38,12 +40,23 @@ button_release_event_cb (StoreAppSmallTile *self)
     return TRUE;
 }
 
+static gboolean
+enter_notify_event_cb (StoreAppSmallTile *self)
+{
+    /* Likely to be opened next */
+    if (self->model != NULL && self->app != NULL)
+        store_model_prefetch_reviews (self->model, self->app);
+    return FALSE;
+}
+
 static void
 store_app_small_tile_dispose (GObject *object)
 {
     StoreAppSmallTile *self = STORE_APP_SMALL_TILE (object);
 
     g_clear_object (&self->app);
+    g_clear_pointer (&self->bindings, g_ptr_array_unref);
+    g_clear_object (&self->model);
 
     G_OBJECT_CLASS (store_app_small_tile_parent_class)->dispose (object);
 }
@@ -59,6 +72,7 @@ store_app_small_tile_class_init (StoreAppSmallTileClass *klass)
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppSmallTile, title_label);
 
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), button_release_event_cb);
+    gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), enter_notify_event_cb);
 
     signals[SIGNAL_ACTIVATED] = g_signal_new ("activated",
                                               G_TYPE_FROM_CLASS (G_OBJECT_CLASS (klass)),
@@ -75,6 +89,8 @@ store_app_small_tile_init (StoreAppSmallTile *self)
 {
     store_image_get_type ();
     gtk_widget_init_template (GTK_WIDGET (self));
+
+    self->bindings = g_ptr_array_new_with_free_func (g_object_unref);
 }
 
 StoreAppSmallTile *
@@ -95,8 +111,16 @@ store_app_small_tile_set_app (StoreAppSmallTile *self, StoreApp *app)
     if (app != NULL)
         self->app = g_object_ref (app);
 
-    g_object_bind_property (app, "icon", self->icon_image, "media", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "title", self->title_label, "label", G_BINDING_SYNC_CREATE);
+    /* Tiles are reused, so stop following the previous app */
+    for (guint i = 0; i < self->bindings->len; i++)
+        g_binding_unbind (g_ptr_array_index (self->bindings, i));
+    g_ptr_array_set_size (self->bindings, 0);
+
+    if (app == NULL)
+        return;
+
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "icon", self->icon_image, "media", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "title", self->title_label, "label", G_BINDING_SYNC_CREATE)));
 }
 
 StoreApp *
@@ -110,5 +134,6 @@ void
 store_app_small_tile_set_model (StoreAppSmallTile *self, StoreModel *model)
 {
     g_return_if_fail (STORE_IS_APP_SMALL_TILE (self));
+    g_set_object (&self->model, model);
     store_image_set_model (self->icon_image, model);
 }
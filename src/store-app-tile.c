@@ -24,6 +24,8 @@ struct _StoreAppTile
     GtkLabel *title_label;
 
     StoreApp *app;
+    GPtrArray *bindings;
+    StoreModel *model;
 };
 
 G_DEFINE_TYPE (StoreAppTile, store_app_tile, GTK_TYPE_EVENT_BOX)
@@ -43,12 +45,23 @@ button_release_event_cb (StoreAppTile *self)
     return TRUE;
 }
 
+static gboolean
+enter_notify_event_cb (StoreAppTile *self)
+{
+    /* Likely to be opened next */
+    if (self->model != NULL && self->app != NULL)
+        store_model_prefetch_reviews (self->model, self->app);
+    return FALSE;
+}
+
 static void
 store_app_tile_dispose (GObject *object)
 {
     StoreAppTile *self = STORE_APP_TILE (object);
 
     g_clear_object (&self->app);
+    g_clear_pointer (&self->bindings, g_ptr_array_unref);
+    g_clear_object (&self->model);
 
     G_OBJECT_CLASS (store_app_tile_parent_class)->dispose (object);
 }
@@ -68,6 +81,7 @@ store_app_tile_class_init (StoreAppTileClass *klass)
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreAppTile, title_label);
 
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), button_release_event_cb);
+    gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), enter_notify_event_cb);
 
     signals[SIGNAL_ACTIVATED] = g_signal_new ("activated",
                                               G_TYPE_FROM_CLASS (G_OBJECT_CLASS (klass)),
@@ -85,6 +99,8 @@ store_app_tile_init (StoreAppTile *self)
     store_image_get_type ();
     store_rating_label_get_type ();
     gtk_widget_init_template (GTK_WIDGET (self));
+
+    self->bindings = g_ptr_array_new_with_free_func (g_object_unref);
 }
 
 StoreAppTile *
@@ -97,6 +113,7 @@ void
 store_app_tile_set_model (StoreAppTile *self, StoreModel *model)
 {
     g_return_if_fail (STORE_IS_APP_TILE (self));
+    g_set_object (&self->model, model);
     store_image_set_model (self->icon_image, model);
 }
 
@@ -112,12 +129,20 @@ store_app_tile_set_app (StoreAppTile *self, StoreApp *app)
     if (app != NULL)
         self->app = g_object_ref (app);
 
-    g_object_bind_property (app, "icon", self->icon_image, "media", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "publisher", self->publisher_label, "label", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "publisher-validated", self->publisher_validated_image, "visible", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "review-average", self->rating_label, "rating", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "summary", self->summary_label, "label", G_BINDING_SYNC_CREATE);
-    g_object_bind_property (app, "title", self->title_label, "label", G_BINDING_SYNC_CREATE);
+    /* Tiles are reused, so stop following the previous app */
+    for (guint i = 0; i < self->bindings->len; i++)
+        g_binding_unbind (g_ptr_array_index (self->bindings, i));
+    g_ptr_array_set_size (self->bindings, 0);
+
+    if (app == NULL)
+        return;
+
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "icon", self->icon_image, "media", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "publisher", self->publisher_label, "label", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "publisher-validated", self->publisher_validated_image, "visible", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "review-average", self->rating_label, "rating", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "summary", self->summary_label, "label", G_BINDING_SYNC_CREATE)));
+    g_ptr_array_add (self->bindings, g_object_ref (g_object_bind_property (app, "title", self->title_label, "label", G_BINDING_SYNC_CREATE)));
 }
 
 StoreApp *
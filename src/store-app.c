@@ -10,6 +10,7 @@
 #include <math.h>
 
 #include "store-app.h"
+#include "store-odrs-review.h"
 
 typedef struct
 {
@@ -21,9 +22,9 @@ typedef struct
     StoreMedia *icon;
     gboolean installed;
     gint64 installed_size;
-    gchar *license;
+    const gchar *license;
     gchar *name;
-    gchar *publisher;
+    const gchar *publisher;
     gboolean publisher_validated;
     gint64 review_count_one_star;
     gint64 review_count_two_star;
@@ -68,8 +69,50 @@ enum
     PROP_LAST
 };
 
+static GParamSpec *properties[PROP_LAST] = { NULL, };
+
 G_DEFINE_TYPE_WITH_PRIVATE (StoreApp, store_app, G_TYPE_OBJECT)
 
+static gboolean media_equal (StoreMedia *media1, StoreMedia *media2)
+{
+    if (media1 == media2)
+        return TRUE;
+    if (media1 == NULL || media2 == NULL)
+        return FALSE;
+    return store_media_equal (media1, media2);
+}
+
+static gboolean review_equal (StoreOdrsReview *review1, StoreOdrsReview *review2)
+{
+    return store_odrs_review_get_id (review1) == store_odrs_review_get_id (review2) &&
+           store_odrs_review_get_rating (review1) == store_odrs_review_get_rating (review2) &&
+           g_strcmp0 (store_odrs_review_get_summary (review1), store_odrs_review_get_summary (review2)) == 0 &&
+           g_strcmp0 (store_odrs_review_get_description (review1), store_odrs_review_get_description (review2)) == 0;
+}
+
+/* New arrays are made on each update, so compare the contents */
+static gboolean arrays_equal (GPtrArray *array1, GPtrArray *array2, GEqualFunc equal_func)
+{
+    if (array1 == array2)
+        return TRUE;
+    if (array1 == NULL || array2 == NULL || array1->len != array2->len)
+        return FALSE;
+    for (guint i = 0; i < array1->len; i++)
+        if (!equal_func (g_ptr_array_index (array1, i), g_ptr_array_index (array2, i)))
+            return FALSE;
+    return TRUE;
+}
+
+/* The total and average are derived from each count */
+static void notify_review_counts (StoreApp *self, guint prop_id)
+{
+    g_object_freeze_notify (G_OBJECT (self));
+    g_object_notify_by_pspec (G_OBJECT (self), properties[prop_id]);
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_REVIEW_COUNT]);
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_REVIEW_AVERAGE]);
+    g_object_thaw_notify (G_OBJECT (self));
+}
+
 static void store_app_dispose (GObject *object)
 {
     StoreApp *self = STORE_APP (object);
@@ -81,9 +124,7 @@ static void store_app_dispose (GObject *object)
     g_clear_pointer (&priv->contact, g_free);
     g_clear_pointer (&priv->description, g_free);
     g_clear_object (&priv->icon);
-    g_clear_pointer (&priv->license, g_free);
     g_clear_pointer (&priv->name, g_free);
-    g_clear_pointer (&priv->publisher, g_free);
     g_clear_pointer (&priv->reviews, g_ptr_array_unref);
     g_clear_pointer (&priv->screenshots, g_ptr_array_unref);
     g_clear_pointer (&priv->summary, g_free);
@@ -259,30 +300,26 @@ static void store_app_set_property (GObject *object, guint prop_id, const GValue
 
 static void install_string_property (StoreAppClass *klass, guint property_id, const gchar *name)
 {
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     property_id,
-                                     g_param_spec_string (name, NULL, NULL, NULL, G_PARAM_READWRITE));
+    properties[property_id] = g_param_spec_string (name, NULL, NULL, NULL, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), property_id, properties[property_id]);
 }
 
 static void install_array_property (StoreAppClass *klass, guint property_id, const gchar *name)
 {
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     property_id,
-                                     g_param_spec_boxed (name, NULL, NULL, G_TYPE_PTR_ARRAY, G_PARAM_READWRITE));
+    properties[property_id] = g_param_spec_boxed (name, NULL, NULL, G_TYPE_PTR_ARRAY, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), property_id, properties[property_id]);
 }
 
 static void install_object_property (StoreAppClass *klass, guint property_id, const gchar *name, GType type)
 {
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     property_id,
-                                     g_param_spec_object (name, NULL, NULL, type, G_PARAM_READWRITE));
+    properties[property_id] = g_param_spec_object (name, NULL, NULL, type, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), property_id, properties[property_id]);
 }
 
 static void install_boolean_property (StoreAppClass *klass, guint property_id, const gchar *name)
 {
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     property_id,
-                                     g_param_spec_boolean (name, NULL, NULL, FALSE, G_PARAM_READWRITE));
+    properties[property_id] = g_param_spec_boolean (name, NULL, NULL, FALSE, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), property_id, properties[property_id]);
 }
 
 static void store_app_class_init (StoreAppClass *klass)
@@ -297,41 +334,32 @@ static void store_app_class_init (StoreAppClass *klass)
     install_string_property (klass, PROP_DESCRIPTION, "description");
     install_object_property (klass, PROP_ICON, "icon", store_media_get_type ());
     install_boolean_property (klass, PROP_INSTALLED, "installed");
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_INSTALLED_SIZE,
-                                     g_param_spec_int64 ("installed-size", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE));
+    properties[PROP_INSTALLED_SIZE] = g_param_spec_int64 ("installed-size", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_INSTALLED_SIZE, properties[PROP_INSTALLED_SIZE]);
     install_string_property (klass, PROP_LICENSE, "license");
     install_string_property (klass, PROP_NAME, "name");
     install_string_property (klass, PROP_PUBLISHER, "publisher");
     install_boolean_property (klass, PROP_PUBLISHER_VALIDATED, "publisher-validated");
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_AVERAGE,
-                                     g_param_spec_int ("review-average", NULL, NULL, G_MININT, G_MAXINT, 0, G_PARAM_READABLE));
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_COUNT,
-                                     g_param_spec_int64 ("review-count", NULL, NULL, G_MININT, G_MAXINT, 0, G_PARAM_READABLE));
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_COUNT_ONE_STAR,
-                                     g_param_spec_int64 ("review-count-one-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE));
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_COUNT_TWO_STAR,
-                                     g_param_spec_int64 ("review-count-two-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE));
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_COUNT_THREE_STAR,
-                                     g_param_spec_int64 ("review-count-three-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE));
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_COUNT_FOUR_STAR,
-                                     g_param_spec_int64 ("review-count-four-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE));
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_REVIEW_COUNT_FIVE_STAR,
-                                     g_param_spec_int64 ("review-count-five-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE));
+    properties[PROP_REVIEW_AVERAGE] = g_param_spec_int ("review-average", NULL, NULL, G_MININT, G_MAXINT, 0, G_PARAM_READABLE);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_AVERAGE, properties[PROP_REVIEW_AVERAGE]);
+    properties[PROP_REVIEW_COUNT] = g_param_spec_int64 ("review-count", NULL, NULL, G_MININT, G_MAXINT, 0, G_PARAM_READABLE);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_COUNT, properties[PROP_REVIEW_COUNT]);
+    properties[PROP_REVIEW_COUNT_ONE_STAR] = g_param_spec_int64 ("review-count-one-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_COUNT_ONE_STAR, properties[PROP_REVIEW_COUNT_ONE_STAR]);
+    properties[PROP_REVIEW_COUNT_TWO_STAR] = g_param_spec_int64 ("review-count-two-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_COUNT_TWO_STAR, properties[PROP_REVIEW_COUNT_TWO_STAR]);
+    properties[PROP_REVIEW_COUNT_THREE_STAR] = g_param_spec_int64 ("review-count-three-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_COUNT_THREE_STAR, properties[PROP_REVIEW_COUNT_THREE_STAR]);
+    properties[PROP_REVIEW_COUNT_FOUR_STAR] = g_param_spec_int64 ("review-count-four-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_COUNT_FOUR_STAR, properties[PROP_REVIEW_COUNT_FOUR_STAR]);
+    properties[PROP_REVIEW_COUNT_FIVE_STAR] = g_param_spec_int64 ("review-count-five-star", NULL, NULL, G_MININT64, G_MAXINT64, 0, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REVIEW_COUNT_FIVE_STAR, properties[PROP_REVIEW_COUNT_FIVE_STAR]);
     install_array_property (klass, PROP_REVIEWS, "reviews");
     install_array_property (klass, PROP_SCREENSHOTS, "screenshots");
     install_string_property (klass, PROP_SUMMARY, "summary");
     install_string_property (klass, PROP_TITLE, "title");
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_UPDATED_DATE,
-                                     g_param_spec_boxed ("updated-date", NULL, NULL, G_TYPE_DATE_TIME, G_PARAM_READWRITE));
+    properties[PROP_UPDATED_DATE] = g_param_spec_boxed ("updated-date", NULL, NULL, G_TYPE_DATE_TIME, G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY);
+    g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_UPDATED_DATE, properties[PROP_UPDATED_DATE]);
     install_string_property (klass, PROP_VERSION, "version");
 }
 
@@ -394,10 +422,25 @@ void store_app_save_to_cache (StoreApp *self, StoreCache *cache)
     STORE_APP_GET_CLASS (self)->save_to_cache (self, cache);
 }
 
+void store_app_update_details_from_cache (StoreApp *self, StoreCache *cache)
+{
+    g_return_if_fail (STORE_IS_APP (self));
+    if (STORE_APP_GET_CLASS (self)->update_details_from_cache == NULL)
+        return;
+
+    /* Send all the changes together once the details are loaded */
+    g_object_freeze_notify (G_OBJECT (self));
+    STORE_APP_GET_CLASS (self)->update_details_from_cache (self, cache);
+    g_object_thaw_notify (G_OBJECT (self));
+}
+
 void store_app_update_from_cache (StoreApp *self, StoreCache *cache)
 {
     g_return_if_fail (STORE_IS_APP (self));
+
+    g_object_freeze_notify (G_OBJECT (self));
     STORE_APP_GET_CLASS (self)->update_from_cache (self, cache);
+    g_object_thaw_notify (G_OBJECT (self));
 }
 
 void store_app_set_appstream_id (StoreApp *self, const gchar *appstream_id)
@@ -406,6 +449,9 @@ void store_app_set_appstream_id (StoreApp *self, const gchar *appstream_id)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->appstream_id, appstream_id) == 0)
+        return;
+
     g_clear_pointer (&priv->appstream_id, g_free);
     priv->appstream_id = g_strdup (appstream_id);
 }
@@ -425,11 +471,12 @@ void store_app_set_banner (StoreApp *self, StoreMedia *banner)
 
     g_return_if_fail (STORE_IS_APP (self));
 
-    g_clear_object (&priv->banner);
-    if (banner != NULL)
-        priv->banner = g_object_ref (banner);
+    if (media_equal (priv->banner, banner))
+        return;
 
-    g_object_notify (G_OBJECT (self), "banner");
+    g_set_object (&priv->banner, banner);
+
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_BANNER]);
 }
 
 StoreMedia * store_app_get_banner (StoreApp *self)
@@ -447,11 +494,14 @@ void store_app_set_channels (StoreApp *self, GPtrArray *channels)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (arrays_equal (priv->channels, channels, (GEqualFunc) store_channel_equal))
+        return;
+
     g_clear_pointer (&priv->channels, g_ptr_array_unref);
     if (channels != NULL)
         priv->channels = g_ptr_array_ref (channels);
 
-    g_object_notify (G_OBJECT (self), "channels");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_CHANNELS]);
 }
 
 GPtrArray * store_app_get_channels (StoreApp *self)
@@ -469,10 +519,13 @@ void store_app_set_contact (StoreApp *self, const gchar *contact)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->contact, contact) == 0)
+        return;
+
     g_clear_pointer (&priv->contact, g_free);
     priv->contact = g_strdup (contact);
 
-    g_object_notify (G_OBJECT (self), "contact");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_CONTACT]);
 }
 
 const gchar *store_app_get_contact (StoreApp *self)
@@ -490,10 +543,13 @@ void store_app_set_description (StoreApp *self, const gchar *description)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->description, description) == 0)
+        return;
+
     g_clear_pointer (&priv->description, g_free);
     priv->description = g_strdup (description);
 
-    g_object_notify (G_OBJECT (self), "description");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_DESCRIPTION]);
 }
 
 const gchar * store_app_get_description (StoreApp *self)
@@ -511,11 +567,12 @@ void store_app_set_icon (StoreApp *self, StoreMedia *icon)
 
     g_return_if_fail (STORE_IS_APP (self));
 
-    g_clear_object (&priv->icon);
-    if (icon != NULL)
-        priv->icon = g_object_ref (icon);
+    if (media_equal (priv->icon, icon))
+        return;
 
-    g_object_notify (G_OBJECT (self), "icon");
+    g_set_object (&priv->icon, icon);
+
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_ICON]);
 }
 
 StoreMedia *
@@ -534,9 +591,12 @@ void store_app_set_installed (StoreApp *self, gboolean installed)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->installed == installed)
+        return;
+
     priv->installed = installed;
 
-    g_object_notify (G_OBJECT (self), "installed");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_INSTALLED]);
 }
 
 gboolean store_app_get_installed (StoreApp *self)
@@ -554,9 +614,12 @@ void store_app_set_installed_size (StoreApp *self, gint64 size)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->installed_size == size)
+        return;
+
     priv->installed_size = size;
 
-    g_object_notify (G_OBJECT (self), "installed-size");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_INSTALLED_SIZE]);
 }
 
 gint64 store_app_get_installed_size (StoreApp *self)
@@ -574,10 +637,14 @@ void store_app_set_license (StoreApp *self, const gchar *license)
 
     g_return_if_fail (STORE_IS_APP (self));
 
-    g_clear_pointer (&priv->license, g_free);
-    priv->license = g_strdup (license);
+    /* Shared by many apps, so only one copy is kept */
+    license = g_intern_string (license);
+    if (priv->license == license)
+        return;
 
-    g_object_notify (G_OBJECT (self), "license");
+    priv->license = license;
+
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_LICENSE]);
 }
 
 const gchar *store_app_get_license (StoreApp *self)
@@ -595,10 +662,13 @@ void store_app_set_name (StoreApp *self, const gchar *name)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->name, name) == 0)
+        return;
+
     g_clear_pointer (&priv->name, g_free);
     priv->name = g_strdup (name);
 
-    g_object_notify (G_OBJECT (self), "name");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_NAME]);
 }
 
 const gchar *store_app_get_name (StoreApp *self)
@@ -616,10 +686,14 @@ void store_app_set_publisher (StoreApp *self, const gchar *publisher)
 
     g_return_if_fail (STORE_IS_APP (self));
 
-    g_clear_pointer (&priv->publisher, g_free);
-    priv->publisher = g_strdup (publisher);
+    /* Shared by many apps, so only one copy is kept */
+    publisher = g_intern_string (publisher);
+    if (priv->publisher == publisher)
+        return;
+
+    priv->publisher = publisher;
 
-    g_object_notify (G_OBJECT (self), "publisher");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PUBLISHER]);
 }
 
 const gchar *store_app_get_publisher (StoreApp *self)
@@ -637,7 +711,12 @@ void store_app_set_publisher_validated (StoreApp *self, gboolean validated)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->publisher_validated == validated)
+        return;
+
     priv->publisher_validated = validated;
+
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_PUBLISHER_VALIDATED]);
 }
 
 gboolean store_app_get_publisher_validated (StoreApp *self)
@@ -721,11 +800,12 @@ void store_app_set_review_count_one_star (StoreApp *self, gint64 count)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->review_count_one_star == count)
+        return;
+
     priv->review_count_one_star = count;
 
-    g_object_notify (G_OBJECT (self), "review-count-one-star");
-    g_object_notify (G_OBJECT (self), "review-count");
-    g_object_notify (G_OBJECT (self), "review-average");
+    notify_review_counts (self, PROP_REVIEW_COUNT_ONE_STAR);
 }
 
 void store_app_set_review_count_two_star (StoreApp *self, gint64 count)
@@ -734,11 +814,12 @@ void store_app_set_review_count_two_star (StoreApp *self, gint64 count)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->review_count_two_star == count)
+        return;
+
     priv->review_count_two_star = count;
 
-    g_object_notify (G_OBJECT (self), "review-count-two-star");
-    g_object_notify (G_OBJECT (self), "review-count");
-    g_object_notify (G_OBJECT (self), "review-average");
+    notify_review_counts (self, PROP_REVIEW_COUNT_TWO_STAR);
 }
 
 void store_app_set_review_count_three_star (StoreApp *self, gint64 count)
@@ -747,11 +828,12 @@ void store_app_set_review_count_three_star (StoreApp *self, gint64 count)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->review_count_three_star == count)
+        return;
+
     priv->review_count_three_star = count;
 
-    g_object_notify (G_OBJECT (self), "review-count-three-star");
-    g_object_notify (G_OBJECT (self), "review-count");
-    g_object_notify (G_OBJECT (self), "review-average");
+    notify_review_counts (self, PROP_REVIEW_COUNT_THREE_STAR);
 }
 
 void store_app_set_review_count_four_star (StoreApp *self, gint64 count)
@@ -760,11 +842,12 @@ void store_app_set_review_count_four_star (StoreApp *self, gint64 count)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->review_count_four_star == count)
+        return;
+
     priv->review_count_four_star = count;
 
-    g_object_notify (G_OBJECT (self), "review-count-four-star");
-    g_object_notify (G_OBJECT (self), "review-count");
-    g_object_notify (G_OBJECT (self), "review-average");
+    notify_review_counts (self, PROP_REVIEW_COUNT_FOUR_STAR);
 }
 
 void store_app_set_review_count_five_star (StoreApp *self, gint64 count)
@@ -773,11 +856,12 @@ void store_app_set_review_count_five_star (StoreApp *self, gint64 count)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->review_count_five_star == count)
+        return;
+
     priv->review_count_five_star = count;
 
-    g_object_notify (G_OBJECT (self), "review-count-five-star");
-    g_object_notify (G_OBJECT (self), "review-count");
-    g_object_notify (G_OBJECT (self), "review-average");
+    notify_review_counts (self, PROP_REVIEW_COUNT_FIVE_STAR);
 }
 
 void store_app_set_reviews (StoreApp *self, GPtrArray *reviews)
@@ -786,11 +870,14 @@ void store_app_set_reviews (StoreApp *self, GPtrArray *reviews)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (arrays_equal (priv->reviews, reviews, (GEqualFunc) review_equal))
+        return;
+
     g_clear_pointer (&priv->reviews, g_ptr_array_unref);
     if (reviews != NULL)
         priv->reviews = g_ptr_array_ref (reviews);
 
-    g_object_notify (G_OBJECT (self), "reviews");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_REVIEWS]);
 }
 
 GPtrArray *
@@ -809,11 +896,14 @@ void store_app_set_screenshots (StoreApp *self, GPtrArray *screenshots)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (arrays_equal (priv->screenshots, screenshots, (GEqualFunc) media_equal))
+        return;
+
     g_clear_pointer (&priv->screenshots, g_ptr_array_unref);
     if (screenshots != NULL)
         priv->screenshots = g_ptr_array_ref (screenshots);
 
-    g_object_notify (G_OBJECT (self), "screenshots");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SCREENSHOTS]);
 }
 
 GPtrArray *
@@ -832,10 +922,13 @@ void store_app_set_summary (StoreApp *self, const gchar *summary)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->summary, summary) == 0)
+        return;
+
     g_clear_pointer (&priv->summary, g_free);
     priv->summary = g_strdup (summary);
 
-    g_object_notify (G_OBJECT (self), "summary");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_SUMMARY]);
 }
 
 const gchar *
@@ -854,10 +947,13 @@ void store_app_set_title (StoreApp *self, const gchar *title)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->title, title) == 0)
+        return;
+
     g_clear_pointer (&priv->title, g_free);
     priv->title = g_strdup (title);
 
-    g_object_notify (G_OBJECT (self), "title");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_TITLE]);
 }
 
 const gchar *
@@ -876,11 +972,14 @@ void store_app_set_updated_date (StoreApp *self, GDateTime *date)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (priv->updated_date == date || (priv->updated_date != NULL && date != NULL && g_date_time_equal (priv->updated_date, date)))
+        return;
+
     g_clear_pointer (&priv->updated_date, g_date_time_unref);
     if (date != NULL)
         priv->updated_date = g_date_time_ref (date);
 
-    g_object_notify (G_OBJECT (self), "updated-date");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_UPDATED_DATE]);
 }
 
 GDateTime *
@@ -899,10 +998,13 @@ void store_app_set_version (StoreApp *self, const gchar *version)
 
     g_return_if_fail (STORE_IS_APP (self));
 
+    if (g_strcmp0 (priv->version, version) == 0)
+        return;
+
     g_clear_pointer (&priv->version, g_free);
     priv->version = g_strdup (version);
 
-    g_object_notify (G_OBJECT (self), "version");
+    g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_VERSION]);
 }
 
 const gchar *store_app_get_version (StoreApp *self)
@@ -23,15 +23,16 @@ struct _StoreAppClass
 {
     GObjectClass parent_class;
 
-    void      (*install_async)     (StoreApp *app, StoreChannel *channel, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
-    gboolean  (*install_finish)    (StoreApp *app, GAsyncResult *result, GError **error);
-    gboolean  (*launch)            (StoreApp *app, GError **error);
-    void      (*refresh_async)     (StoreApp *app, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
-    gboolean  (*refresh_finish)    (StoreApp *app, GAsyncResult *result, GError **error);
-    void      (*remove_async)      (StoreApp *app, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
-    gboolean  (*remove_finish)     (StoreApp *app, GAsyncResult *result, GError **error);
-    void      (*save_to_cache)     (StoreApp *app, StoreCache *cache);
-    void      (*update_from_cache) (StoreApp *app, StoreCache *cache);
+    void      (*install_async)             (StoreApp *app, StoreChannel *channel, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
+    gboolean  (*install_finish)            (StoreApp *app, GAsyncResult *result, GError **error);
+    gboolean  (*launch)                    (StoreApp *app, GError **error);
+    void      (*refresh_async)             (StoreApp *app, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
+    gboolean  (*refresh_finish)            (StoreApp *app, GAsyncResult *result, GError **error);
+    void      (*remove_async)              (StoreApp *app, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
+    gboolean  (*remove_finish)             (StoreApp *app, GAsyncResult *result, GError **error);
+    void      (*save_to_cache)             (StoreApp *app, StoreCache *cache);
+    void      (*update_details_from_cache) (StoreApp *app, StoreCache *cache);
+    void      (*update_from_cache)         (StoreApp *app, StoreCache *cache);
 };
 
 void          store_app_install_async               (StoreApp *app, StoreChannel *channel, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
@@ -50,6 +51,8 @@ gboolean      store_app_remove_finish               (StoreApp *app, GAsyncResult
 
 void          store_app_save_to_cache               (StoreApp *app, StoreCache *cache);
 
+void          store_app_update_details_from_cache   (StoreApp *app, StoreCache *cache);
+
 void          store_app_update_from_cache           (StoreApp *app, StoreCache *cache);
 
 void          store_app_set_appstream_id            (StoreApp *app, const gchar *appstream_id);
@@ -13,9 +13,25 @@
 
 #include "store-application.h"
 #include "store-category.h"
+#include "store-frame-profiler.h"
+#include "store-metrics.h"
 #include "store-model.h"
+#include "store-trace.h"
 #include "store-window.h"
 
+/* Number of categories and apps in each category visited when profiling page transitions */
+#define PROFILE_CATEGORIES 3
+#define PROFILE_APPS 2
+
+static const gchar metrics_interface_xml[] =
+    "<node>"
+    "  <interface name='io.snapcraft.Store.Metrics'>"
+    "    <method name='GetMetrics'>"
+    "      <arg type='a{sv}' name='metrics' direction='out'/>"
+    "    </method>"
+    "  </interface>"
+    "</node>";
+
 struct _StoreApplication
 {
     GtkApplication parent_instance;
@@ -24,7 +40,12 @@ struct _StoreApplication
 
     GCancellable *cancellable;
     GtkCssProvider *css_provider;
+    StoreFrameProfiler *frame_profiler;
+    guint metrics_registration_id;
     StoreModel *model;
+    gchar *profile_path;
+    guint profile_step;
+    GPtrArray *profile_steps;
 };
 
 G_DEFINE_TYPE (StoreApplication, store_application, GTK_TYPE_APPLICATION)
@@ -37,7 +58,10 @@ store_application_dispose (GObject *object)
     g_cancellable_cancel (self->cancellable);
     g_clear_object (&self->cancellable);
     g_clear_object (&self->css_provider);
+    g_clear_object (&self->frame_profiler);
     g_clear_object (&self->model);
+    g_clear_pointer (&self->profile_path, g_free);
+    g_clear_pointer (&self->profile_steps, g_ptr_array_unref);
 
     G_OBJECT_CLASS (store_application_parent_class)->dispose (object);
 }
@@ -48,6 +72,77 @@ theme_changed_cb (StoreApplication *self)
     gtk_css_provider_load_from_resource (self->css_provider, "/io/snapcraft/Store/gtk-style.css");
 }
 
+static void
+load_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    StoreApplication *self = user_data;
+
+    g_autoptr(GError) error = NULL;
+    if (!store_model_load_finish (STORE_MODEL (object), result, &error)) {
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            return;
+        g_warning ("Failed to load cache: %s", error->message);
+    }
+
+    /* Checked after the cached ratings are loaded, so they are only downloaded if changed */
+    store_model_update_ratings_async (self->model, NULL, NULL, NULL);
+}
+
+static void
+after_paint_cb (GdkFrameClock *frame_clock, StoreApplication *self)
+{
+    store_trace_mark ("window", "first-frame");
+    g_signal_handlers_disconnect_by_func (frame_clock, after_paint_cb, self);
+}
+
+static void
+run_next_profile_step (StoreApplication *self)
+{
+    if (self->profile_step >= self->profile_steps->len) {
+        g_autoptr(GError) error = NULL;
+        if (!store_frame_profiler_write (self->frame_profiler, self->profile_path, &error))
+            g_warning ("Failed to write frame profile: %s", error->message);
+        g_application_quit (G_APPLICATION (self));
+        return;
+    }
+
+    GObject *step = g_ptr_array_index (self->profile_steps, self->profile_step);
+    self->profile_step++;
+    if (STORE_IS_CATEGORY (step))
+        store_window_show_category (self->window, STORE_CATEGORY (step));
+    else
+        store_window_show_app (self->window, STORE_APP (step));
+}
+
+/* Visits the same pages twice, to compare showing new content with showing content that has been seen before */
+static void
+profile_categories_changed_cb (StoreApplication *self)
+{
+    g_autoptr(GPtrArray) steps = g_ptr_array_new_with_free_func (g_object_unref);
+    GPtrArray *categories = store_model_get_categories (self->model);
+    for (guint i = 0; i < categories->len && i < PROFILE_CATEGORIES; i++) {
+        StoreCategory *category = g_ptr_array_index (categories, i);
+        GPtrArray *apps = store_category_get_apps (category);
+
+        if (apps->len == 0)
+            continue;
+        g_ptr_array_add (steps, g_object_ref (category));
+        for (guint j = 0; j < apps->len && j < PROFILE_APPS; j++)
+            g_ptr_array_add (steps, g_object_ref (g_ptr_array_index (apps, j)));
+    }
+    if (steps->len == 0)
+        return;
+
+    g_signal_handlers_disconnect_by_func (self->model, profile_categories_changed_cb, self);
+
+    self->profile_steps = g_ptr_array_new_with_free_func (g_object_unref);
+    for (guint pass = 0; pass < 2; pass++)
+        for (guint i = 0; i < steps->len; i++)
+            g_ptr_array_add (self->profile_steps, g_object_ref (g_ptr_array_index (steps, i)));
+    g_signal_connect_object (self->frame_profiler, "transition-finished", G_CALLBACK (run_next_profile_step), self, G_CONNECT_SWAPPED);
+    run_next_profile_step (self);
+}
+
 static int
 store_application_command_line (GApplication *application, GApplicationCommandLine *command_line)
 {
@@ -55,6 +150,15 @@ store_application_command_line (GApplication *application, GApplicationCommandLi
 
     GVariantDict *options = g_application_command_line_get_options_dict (command_line);
 
+    if (g_variant_dict_contains (options, "trace")) {
+        const gchar *path;
+        g_variant_dict_lookup (options, "trace", "^&ay", &path);
+        store_trace_enable (path);
+    }
+
+    if (g_variant_dict_contains (options, "filter-ratings"))
+        store_model_set_filter_ratings (self->model, TRUE);
+
     if (g_variant_dict_contains (options, "no-cache"))
         store_model_set_cache (self->model, NULL);
 
@@ -64,23 +168,42 @@ store_application_command_line (GApplication *application, GApplicationCommandLi
         store_model_set_odrs_server_uri (self->model, uri);
     }
 
+    if (g_variant_dict_contains (options, "ratings-max-age")) {
+        gint64 max_age;
+        g_variant_dict_lookup (options, "ratings-max-age", "x", &max_age);
+        store_model_set_ratings_max_age (self->model, max_age);
+    }
+
     if (g_variant_dict_contains (options, "snapd-socket-path")) {
         const gchar *path;
         g_variant_dict_lookup (options, "snapd-socket-path", "&s", &path);
         store_model_set_snapd_socket_path (self->model, path);
     }
 
+    if (g_variant_dict_contains (options, "profile-pages")) {
+        const gchar *path;
+        g_variant_dict_lookup (options, "profile-pages", "^&ay", &path);
+        g_free (self->profile_path);
+        self->profile_path = g_strdup (path);
+    }
+
     if (g_variant_dict_contains (options, "version")) {
         g_print ("snap-store " VERSION "\n");
         return 0;
     }
 
-    store_model_load (self->model);
-    store_model_update_ratings_async (self->model, NULL, NULL, NULL);
+    store_model_load_async (self->model, self->cancellable, load_cb, self);
 
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("window", "load", NULL);
     self->window = store_window_new (self);
     store_window_set_model (self->window, self->model);
     store_window_load (self->window);
+    g_clear_pointer (&span, store_trace_end);
+
+    if (g_variant_dict_contains (options, "profile-frames") || self->profile_path != NULL) {
+        self->frame_profiler = store_frame_profiler_new ();
+        store_window_set_frame_profiler (self->window, self->frame_profiler);
+    }
 
     int args_length;
     g_auto(GStrv) args = g_application_command_line_get_arguments (command_line, &args_length);
@@ -109,9 +232,61 @@ store_application_command_line (GApplication *application, GApplicationCommandLi
 
     gtk_window_present (GTK_WINDOW (self->window));
 
+    GdkFrameClock *frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (self->window));
+    if (store_trace_get_enabled () && frame_clock != NULL)
+        g_signal_connect_object (frame_clock, "after-paint", G_CALLBACK (after_paint_cb), self, 0);
+
+    /* Wait until there are categories to visit */
+    if (self->profile_path != NULL) {
+        g_signal_connect_object (self->model, "notify::categories", G_CALLBACK (profile_categories_changed_cb), self, G_CONNECT_SWAPPED);
+        profile_categories_changed_cb (self);
+    }
+
     return -1;
 }
 
+static void
+metrics_method_call_cb (GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED, const gchar *object_path G_GNUC_UNUSED,
+                        const gchar *interface_name G_GNUC_UNUSED, const gchar *method_name, GVariant *parameters G_GNUC_UNUSED,
+                        GDBusMethodInvocation *invocation, gpointer user_data G_GNUC_UNUSED)
+{
+    if (g_strcmp0 (method_name, "GetMetrics") == 0)
+        g_dbus_method_invocation_return_value (invocation, g_variant_new ("(@a{sv})", store_metrics_get_variant ()));
+    else
+        g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD, "Unknown method %s", method_name);
+}
+
+static const GDBusInterfaceVTable metrics_vtable = { metrics_method_call_cb, NULL, NULL };
+
+/* Export performance counters so they can be read with e.g. gdbus call --session --dest io.snapcraft.Store --object-path /io/snapcraft/Store --method io.snapcraft.Store.Metrics.GetMetrics */
+static gboolean
+store_application_dbus_register (GApplication *application, GDBusConnection *connection, const gchar *object_path, GError **error)
+{
+    StoreApplication *self = STORE_APPLICATION (application);
+
+    if (!G_APPLICATION_CLASS (store_application_parent_class)->dbus_register (application, connection, object_path, error))
+        return FALSE;
+
+    g_autoptr(GDBusNodeInfo) node_info = g_dbus_node_info_new_for_xml (metrics_interface_xml, error);
+    if (node_info == NULL)
+        return FALSE;
+
+    self->metrics_registration_id = g_dbus_connection_register_object (connection, object_path, node_info->interfaces[0], &metrics_vtable, self, NULL, error);
+    return self->metrics_registration_id != 0;
+}
+
+static void
+store_application_dbus_unregister (GApplication *application, GDBusConnection *connection, const gchar *object_path)
+{
+    StoreApplication *self = STORE_APPLICATION (application);
+
+    if (self->metrics_registration_id != 0)
+        g_dbus_connection_unregister_object (connection, self->metrics_registration_id);
+    self->metrics_registration_id = 0;
+
+    G_APPLICATION_CLASS (store_application_parent_class)->dbus_unregister (application, connection, object_path);
+}
+
 static void
 store_application_startup (GApplication *application)
 {
@@ -137,6 +312,8 @@ store_application_class_init (StoreApplicationClass *klass)
 {
     G_OBJECT_CLASS (klass)->dispose = store_application_dispose;
     G_APPLICATION_CLASS (klass)->command_line = store_application_command_line;
+    G_APPLICATION_CLASS (klass)->dbus_register = store_application_dbus_register;
+    G_APPLICATION_CLASS (klass)->dbus_unregister = store_application_dbus_unregister;
     G_APPLICATION_CLASS (klass)->startup = store_application_startup;
     G_APPLICATION_CLASS (klass)->activate = store_application_activate;
 }
@@ -148,6 +325,9 @@ store_application_init (StoreApplication *self)
         { "version", 0, 0, G_OPTION_ARG_NONE, NULL,
            /* Help text for --version command line option */
            _("Show version number"), NULL },
+        { "filter-ratings", 0, 0, G_OPTION_ARG_NONE, NULL,
+           /* Help text for --filter-ratings command line option */
+           _("Only keep ratings for snaps that have been seen, to save memory"), NULL },
         { "no-cache", 0, 0, G_OPTION_ARG_NONE, NULL,
            /* Help text for --no-cache command line option */
            _("Disable caching"), NULL },
@@ -156,11 +336,29 @@ store_application_init (StoreApplication *self)
            _("ODRS server URI"),
            /* Help text for argument to --odrs-server command line option */
            _("URI") },
+        { "profile-frames", 0, 0, G_OPTION_ARG_NONE, NULL,
+           /* Help text for --profile-frames command line option */
+           _("Log frame times and layout costs when switching pages"), NULL },
+        { "profile-pages", 0, 0, G_OPTION_ARG_FILENAME, NULL,
+           /* Help text for --profile-pages command line option */
+           _("Switch through a set of pages, write the frame times to a file and quit"),
+           /* Help text for argument to --profile-pages command line option */
+           _("FILE") },
+        { "ratings-max-age", 0, 0, G_OPTION_ARG_INT64, NULL,
+           /* Help text for --ratings-max-age command line option */
+           _("Time to use downloaded ratings for before checking for new ones"),
+           /* Help text for argument to --ratings-max-age command line option */
+           _("SECONDS") },
         { "snapd-socket-path", 0, 0, G_OPTION_ARG_STRING, NULL,
            /* Help text for --snapd-socket-path command line option */
            _("Socket snapd server is using"),
            /* Help text for argument to --snapd-socket-path command line option */
            _("PATH") },
+        { "trace", 0, 0, G_OPTION_ARG_FILENAME, NULL,
+           /* Help text for --trace command line option */
+           _("Write a performance trace to a file on exit"),
+           /* Help text for argument to --trace command line option */
+           _("FILE") },
         { NULL }
     };
 
@@ -8,6 +8,8 @@
  */
 
 #include "store-cache.h"
+#include "store-metrics.h"
+#include "store-trace.h"
 
 struct _StoreCache
 {
@@ -16,6 +18,47 @@ struct _StoreCache
 
 G_DEFINE_TYPE (StoreCache, store_cache, G_TYPE_OBJECT)
 
+typedef struct
+{
+    StoreTraceSpan *span;
+    gchar *type;
+} LookupData;
+
+static LookupData *
+lookup_data_new (const gchar *type, StoreTraceSpan *span)
+{
+    LookupData *data = g_new0 (LookupData, 1);
+    data->span = span;
+    data->type = g_strdup (type);
+    return data;
+}
+
+static void
+lookup_data_free (LookupData *data)
+{
+    store_trace_end (data->span);
+    g_free (data->type);
+    g_free (data);
+}
+
+/* Cancelled lookups are neither a hit nor a miss */
+static void
+add_lookup_metrics (const gchar *type, gsize contents_length, GError *error)
+{
+    if (error == NULL)
+        store_metrics_add_cache_lookup (type, TRUE, contents_length);
+    else if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        store_metrics_add_cache_lookup (type, FALSE, 0);
+}
+
+static gchar *
+get_trace_detail (const gchar *type, const gchar *name)
+{
+    if (!store_trace_get_enabled ())
+        return NULL;
+    return g_strdup_printf ("%s/%s", type, name);
+}
+
 static GFile *
 get_cache_file (const gchar *type, const gchar *name, gboolean hash)
 {
@@ -33,11 +76,16 @@ static void
 contents_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 {
     g_autoptr(GTask) task = user_data;
+    LookupData *data = g_task_get_task_data (task);
+
+    g_clear_pointer (&data->span, store_trace_end);
 
     g_autoptr(GError) error = NULL;
     g_autofree gchar *contents = NULL;
-    gsize contents_length;
-    if (!g_file_load_contents_finish (G_FILE (object), result, &contents, &contents_length, NULL, &error)) {
+    gsize contents_length = 0;
+    gboolean loaded = g_file_load_contents_finish (G_FILE (object), result, &contents, &contents_length, NULL, &error);
+    add_lookup_metrics (data->type, contents_length, error);
+    if (!loaded) {
         g_task_return_error (task, g_steal_pointer (&error));
         return;
     }
@@ -66,6 +114,9 @@ store_cache_insert (StoreCache *self, const gchar *type, const gchar *name, gboo
 {
     g_return_val_if_fail (STORE_IS_CACHE (self), FALSE);
 
+    g_autofree gchar *detail = get_trace_detail (type, name);
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("cache", "write", detail);
+
     g_autoptr(GFile) file = get_cache_file (type, name, hash);
 
     g_autofree gchar *path = g_file_get_path (file);
@@ -74,6 +125,7 @@ store_cache_insert (StoreCache *self, const gchar *type, const gchar *name, gboo
 
     gsize contents_length;
     const gchar *contents = g_bytes_get_data (data, &contents_length);
+    store_metrics_add_cache_write (type, contents_length);
     return g_file_replace_contents (file, contents, contents_length, NULL, FALSE, G_FILE_CREATE_PRIVATE, NULL, cancellable, error);
 }
 
@@ -98,7 +150,9 @@ store_cache_lookup_async (StoreCache *self, const gchar *type, const gchar *name
 
     g_autoptr(GFile) file = get_cache_file (type, name, hash);
 
+    g_autofree gchar *detail = get_trace_detail (type, name);
     GTask *task = g_task_new (self, cancellable, callback, callback_data);
+    g_task_set_task_data (task, lookup_data_new (type, store_trace_begin_async ("cache", "read", detail)), (GDestroyNotify) lookup_data_free);
     g_file_load_contents_async (file, cancellable, contents_cb, task);
 }
 
@@ -116,12 +170,20 @@ store_cache_lookup_sync (StoreCache *self, const gchar *type, const gchar *name,
 {
     g_return_val_if_fail (STORE_IS_CACHE (self), NULL);
 
+    g_autofree gchar *detail = get_trace_detail (type, name);
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("cache", "read", detail);
+
     g_autoptr(GFile) file = get_cache_file (type, name, hash);
 
+    g_autoptr(GError) local_error = NULL;
     g_autofree gchar *contents = NULL;
-    gsize contents_length;
-    if (!g_file_load_contents (file, cancellable, &contents, &contents_length, NULL, error))
+    gsize contents_length = 0;
+    gboolean loaded = g_file_load_contents (file, cancellable, &contents, &contents_length, NULL, &local_error);
+    add_lookup_metrics (type, contents_length, local_error);
+    if (!loaded) {
+        g_propagate_error (error, g_steal_pointer (&local_error));
         return NULL;
+    }
 
     return g_bytes_new_take (g_steal_pointer (&contents), contents_length);
 }
@@ -135,6 +197,9 @@ store_cache_lookup_json (StoreCache *self, const gchar *type, const gchar *name,
     if (value == NULL)
         return NULL;
 
+    g_autofree gchar *detail = get_trace_detail (type, name);
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("json", "parse", detail);
+
     g_autoptr(JsonParser) parser = json_parser_new ();
     if (!json_parser_load_from_data (parser, g_bytes_get_data (value, NULL), g_bytes_get_size (value), error))
         return NULL;
@@ -147,3 +212,17 @@ store_cache_lookup_json (StoreCache *self, const gchar *type, const gchar *name,
 
     return json_node_ref (root);
 }
+
+gint64
+store_cache_get_modified_time (StoreCache *self, const gchar *type, const gchar *name, gboolean hash)
+{
+    g_return_val_if_fail (STORE_IS_CACHE (self), 0);
+
+    g_autoptr(GFile) file = get_cache_file (type, name, hash);
+
+    g_autoptr(GFileInfo) info = g_file_query_info (file, G_FILE_ATTRIBUTE_TIME_MODIFIED, G_FILE_QUERY_INFO_NONE, NULL, NULL);
+    if (info == NULL)
+        return 0;
+
+    return g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED);
+}
@@ -10,6 +10,9 @@
 #include "store-category-list.h"
 
 #include "store-app-small-tile.h"
+#include "store-tile-reconciler.h"
+
+#define MAX_APPS 5
 
 struct _StoreCategoryList
 {
@@ -20,6 +23,8 @@ struct _StoreCategoryList
 
     StoreModel *model;
     StoreCategory *category;
+    StoreTileReconciler *reconciler;
+    GBinding *title_binding;
 };
 
 G_DEFINE_TYPE (StoreCategoryList, store_category_list, GTK_TYPE_BOX)
@@ -46,13 +51,34 @@ button_release_event_cb (StoreAppSmallTile *self)
     return TRUE;
 }
 
+static GtkWidget *
+new_tile_cb (StoreCategoryList *self)
+{
+    StoreAppSmallTile *tile = store_app_small_tile_new ();
+    gtk_widget_show (GTK_WIDGET (tile));
+    g_signal_connect_object (tile, "activated", G_CALLBACK (app_activated_cb), self, G_CONNECT_SWAPPED);
+    store_app_small_tile_set_model (tile, self->model);
+    return GTK_WIDGET (tile);
+}
+
+static void
+apps_changed_cb (StoreCategoryList *self)
+{
+    GListModel *apps = self->category != NULL ? store_category_get_app_list (self->category) : NULL;
+    store_tile_reconciler_update_box (self->reconciler, self->app_box, apps, MAX_APPS);
+}
+
 static void
 store_category_list_dispose (GObject *object)
 {
     StoreCategoryList *self = STORE_CATEGORY_LIST (object);
 
     g_clear_object (&self->model);
+    if (self->category != NULL)
+        g_signal_handlers_disconnect_by_func (store_category_get_app_list (self->category), apps_changed_cb, self);
     g_clear_object (&self->category);
+    g_clear_object (&self->reconciler);
+    g_clear_object (&self->title_binding);
 
     G_OBJECT_CLASS (store_category_list_parent_class)->dispose (object);
 }
@@ -93,6 +119,11 @@ static void
 store_category_list_init (StoreCategoryList *self)
 {
     gtk_widget_init_template (GTK_WIDGET (self));
+
+    self->reconciler = store_tile_reconciler_new ((StoreTileNewFunc) new_tile_cb,
+                                                  (StoreTileGetItemFunc) store_app_small_tile_get_app,
+                                                  (StoreTileSetItemFunc) store_app_small_tile_set_app,
+                                                  self);
 }
 
 StoreCategoryList *
@@ -106,36 +137,20 @@ store_category_list_set_category (StoreCategoryList *self, StoreCategory *catego
 {
     g_return_if_fail (STORE_IS_CATEGORY_LIST (self));
 
-    g_set_object (&self->category, category);
-
-    g_object_bind_property (category, "title", self->title_label, "label", G_BINDING_SYNC_CREATE);
-
-    GPtrArray *apps = store_category_get_apps (category); // FIXME Update when apps updates
+    if (self->category == category)
+        return;
 
-    /* Ensure correct number of app tiles */
-    g_autoptr(GList) children = gtk_container_get_children (GTK_CONTAINER (self->app_box));
-    guint n_tiles = g_list_length (children);
-    guint n_apps = apps->len <  5 ? apps->len : 5;
-    while (n_tiles < n_apps) {
-        StoreAppSmallTile *tile = store_app_small_tile_new ();
-        gtk_widget_show (GTK_WIDGET (tile));
-        g_signal_connect_object (tile, "activated", G_CALLBACK (app_activated_cb), self, G_CONNECT_SWAPPED);
-        store_app_small_tile_set_model (tile, self->model);
-        gtk_container_add (GTK_CONTAINER (self->app_box), GTK_WIDGET (tile));
-        n_tiles++;
-        children = g_list_append (children, tile);
-    }
-    while (n_tiles > n_apps) {
-        for (GList *link = g_list_nth (children, n_apps); link != NULL; link = link->next) {
-            StoreAppSmallTile *tile = link->data;
-            gtk_container_remove (GTK_CONTAINER (self->app_box), GTK_WIDGET (tile));
-        }
-    }
-    for (guint i = 0; i < n_apps; i++) {
-        StoreApp *app = g_ptr_array_index (apps, i);
-        StoreAppSmallTile *tile = g_list_nth_data (children, i);
-        store_app_small_tile_set_app (tile, app);
+    if (self->category != NULL)
+        g_signal_handlers_disconnect_by_func (store_category_get_app_list (self->category), apps_changed_cb, self);
+    if (self->title_binding != NULL)
+        g_binding_unbind (self->title_binding);
+    g_clear_object (&self->title_binding);
+    g_set_object (&self->category, category);
+    if (self->category != NULL) {
+        self->title_binding = g_object_ref (g_object_bind_property (category, "title", self->title_label, "label", G_BINDING_SYNC_CREATE));
+        g_signal_connect_object (store_category_get_app_list (category), "items-changed", G_CALLBACK (apps_changed_cb), self, G_CONNECT_SWAPPED);
     }
+    apps_changed_cb (self);
 }
 
 StoreCategory *
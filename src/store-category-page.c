@@ -8,16 +8,18 @@
  */
 
 #include "store-app.h"
-#include "store-app-tile.h"
+#include "store-app-grid.h"
 #include "store-category-page.h"
 
 struct _StoreCategoryPage
 {
     StorePage parent_instance;
 
-    GtkGrid *app_grid;
+    StoreAppGrid *app_grid;
     GtkLabel *summary_label;
     GtkLabel *title_label;
+
+    StoreCategory *category;
 };
 
 G_DEFINE_TYPE (StoreCategoryPage, store_category_page, store_page_get_type ())
@@ -31,15 +33,36 @@ enum
 static guint signals[SIGNAL_LAST] = { 0, };
 
 static void
-app_activated_cb (StoreCategoryPage *self, StoreAppTile *tile)
+app_activated_cb (StoreCategoryPage *self, StoreApp *app)
+{
+    g_signal_emit (self, signals[SIGNAL_APP_ACTIVATED], 0, app);
+}
+
+static void
+end_reached_cb (StoreCategoryPage *self)
+{
+    /* Load the next page of apps when scrolled to the end */
+    StoreModel *model = store_page_get_model (STORE_PAGE (self));
+    if (self->category != NULL && store_model_get_has_more_category_apps (model, self->category))
+        store_model_load_more_category_apps (model, self->category);
+}
+
+static void
+store_category_page_dispose (GObject *object)
 {
-    g_signal_emit (self, signals[SIGNAL_APP_ACTIVATED], 0, store_app_tile_get_app (tile));
+    StoreCategoryPage *self = STORE_CATEGORY_PAGE (object);
+
+    g_clear_object (&self->category);
+
+    G_OBJECT_CLASS (store_category_page_parent_class)->dispose (object);
 }
 
 static void
 store_category_page_set_model (StorePage *page, StoreModel *model)
 {
-    // FIXME: Should apply to children
+    StoreCategoryPage *self = STORE_CATEGORY_PAGE (page);
+
+    store_app_grid_set_model (self->app_grid, model);
 
     STORE_PAGE_CLASS (store_category_page_parent_class)->set_model (page, model);
 }
@@ -47,6 +70,7 @@ store_category_page_set_model (StorePage *page, StoreModel *model)
 static void
 store_category_page_class_init (StoreCategoryPageClass *klass)
 {
+    G_OBJECT_CLASS (klass)->dispose = store_category_page_dispose;
     STORE_PAGE_CLASS (klass)->set_model = store_category_page_set_model;
 
     gtk_widget_class_set_template_from_resource (GTK_WIDGET_CLASS (klass), "/io/snapcraft/Store/store-category-page.ui");
@@ -55,6 +79,9 @@ store_category_page_class_init (StoreCategoryPageClass *klass)
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreCategoryPage, summary_label);
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreCategoryPage, title_label);
 
+    gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), app_activated_cb);
+    gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), end_reached_cb);
+
     signals[SIGNAL_APP_ACTIVATED] = g_signal_new ("app-activated",
                                                   G_TYPE_FROM_CLASS (G_OBJECT_CLASS (klass)),
                                                   G_SIGNAL_RUN_LAST,
@@ -68,6 +95,7 @@ store_category_page_class_init (StoreCategoryPageClass *klass)
 static void
 store_category_page_init (StoreCategoryPage *self)
 {
+    store_app_grid_get_type ();
     gtk_widget_init_template (GTK_WIDGET (self));
 }
 
@@ -76,36 +104,18 @@ store_category_page_set_category (StoreCategoryPage *self, StoreCategory *catego
 {
     g_return_if_fail (STORE_IS_CATEGORY_PAGE (self));
 
+    g_set_object (&self->category, category);
+
     g_object_bind_property (category, "summary", self->summary_label, "label", G_BINDING_SYNC_CREATE);
     g_object_bind_property (category, "title", self->title_label, "label", G_BINDING_SYNC_CREATE);
 
-    GPtrArray *apps = store_category_get_apps (category);
-
-    /* Ensure correct number of app tiles */
-    // FIXME: Make a new widget that does this
-    g_autoptr(GList) children = gtk_container_get_children (GTK_CONTAINER (self->app_grid));
-    guint n_tiles = g_list_length (children);
-    while (n_tiles < apps->len) {
-        StoreAppTile *tile = store_app_tile_new ();
-        gtk_widget_show (GTK_WIDGET (tile));
-        store_app_tile_set_model (tile, store_page_get_model (STORE_PAGE (self)));
-        g_signal_connect_object (tile, "activated", G_CALLBACK (app_activated_cb), self, G_CONNECT_SWAPPED);
-        gtk_grid_attach (self->app_grid, GTK_WIDGET (tile), n_tiles % 3, n_tiles / 3, 1, 1);
-        n_tiles++;
-        children = g_list_append (children, tile);
-    }
-    for (GList *link = children; link != NULL; link = link->next) {
-        GtkWidget *child = link->data;
-        int left_attach, top_attach;
-        gtk_container_child_get (GTK_CONTAINER (self->app_grid), child, "left-attach", &left_attach, "top-attach", &top_attach, NULL);
-        guint index = top_attach * 3 + left_attach;
-        if (index >= apps->len)
-            gtk_container_remove (GTK_CONTAINER (self->app_grid), child);
-    }
+    /* Tiles are updated as the category changes */
+    GListModel *apps = store_category_get_app_list (category);
+    store_app_grid_set_app_list (self->app_grid, apps);
 
-    for (guint i = 0; i < apps->len; i++) {
-        StoreApp *app = g_ptr_array_index (apps, i);
-        StoreAppTile *tile = STORE_APP_TILE (gtk_grid_get_child_at (self->app_grid, i % 3, i / 3));
-        store_app_tile_set_app (tile, app);
+    /* Get reviews for the first row, as they are the most likely to be opened */
+    for (guint i = 0; i < g_list_model_get_n_items (apps) && i < 3; i++) {
+        g_autoptr(StoreApp) app = g_list_model_get_item (apps, i);
+        store_model_prefetch_reviews (store_page_get_model (STORE_PAGE (self)), app);
     }
 }
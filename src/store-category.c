@@ -9,10 +9,14 @@
 
 #include "store-category.h"
 
+#include "store-app.h"
+#include "store-diff.h"
+
 struct _StoreCategory
 {
     GObject parent_instance;
 
+    GListStore *app_list;
     GPtrArray *apps;
     gchar *name;
     gchar *summary;
@@ -36,6 +40,7 @@ store_category_dispose (GObject *object)
 {
     StoreCategory *self = STORE_CATEGORY (object);
 
+    g_clear_object (&self->app_list);
     g_clear_pointer (&self->apps, g_ptr_array_unref);
     g_clear_pointer (&self->name, g_free);
     g_clear_pointer (&self->summary, g_free);
@@ -116,8 +121,9 @@ store_category_class_init (StoreCategoryClass *klass)
 }
 
 static void
-store_category_init (StoreCategory *self G_GNUC_UNUSED)
+store_category_init (StoreCategory *self)
 {
+    self->app_list = g_list_store_new (store_app_get_type ());
 }
 
 StoreCategory *
@@ -133,12 +139,15 @@ store_category_set_apps (StoreCategory *self, GPtrArray *apps)
 
     if (self->apps == apps)
         return;
-    // FIXME: Also check for arrays with same contents
 
     g_clear_pointer (&self->apps, g_ptr_array_unref);
     if (apps != NULL)
         self->apps = g_ptr_array_ref (apps);
 
+    /* Nothing to update if the contents are the same */
+    if (!store_diff_update_list_store (self->app_list, apps))
+        return;
+
     g_object_notify (G_OBJECT (self), "apps");
 }
 
@@ -150,6 +159,14 @@ store_category_get_apps (StoreCategory *self)
     return self->apps;
 }
 
+GListModel *
+store_category_get_app_list (StoreCategory *self)
+{
+    g_return_val_if_fail (STORE_IS_CATEGORY (self), NULL);
+
+    return G_LIST_MODEL (self->app_list);
+}
+
 void
 store_category_set_name (StoreCategory *self, const gchar *name)
 {
@@ -9,7 +9,7 @@
 
 #pragma once
 
-#include <glib-object.h>
+#include <gio/gio.h>
 
 G_BEGIN_DECLS
 
@@ -17,20 +17,22 @@ G_DECLARE_FINAL_TYPE (StoreCategory, store_category, STORE, CATEGORY, GObject)
 
 StoreCategory *store_category_new (void);
 
-void           store_category_set_apps    (StoreCategory *category, GPtrArray *apps);
+void           store_category_set_apps     (StoreCategory *category, GPtrArray *apps);
 
-GPtrArray     *store_category_get_apps    (StoreCategory *category);
+GPtrArray     *store_category_get_apps     (StoreCategory *category);
 
-void           store_category_set_name    (StoreCategory *category, const gchar *name);
+GListModel    *store_category_get_app_list (StoreCategory *category);
 
-const gchar   *store_category_get_name    (StoreCategory *category);
+void           store_category_set_name     (StoreCategory *category, const gchar *name);
 
-void           store_category_set_summary (StoreCategory *category, const gchar *summary);
+const gchar   *store_category_get_name     (StoreCategory *category);
 
-const gchar   *store_category_get_summary (StoreCategory *category);
+void           store_category_set_summary  (StoreCategory *category, const gchar *summary);
 
-void           store_category_set_title   (StoreCategory *category, const gchar *title);
+const gchar   *store_category_get_summary  (StoreCategory *category);
 
-const gchar   *store_category_get_title   (StoreCategory *category);
+void           store_category_set_title    (StoreCategory *category, const gchar *title);
+
+const gchar   *store_category_get_title    (StoreCategory *category);
 
 G_END_DECLS
@@ -13,7 +13,7 @@ struct _StoreChannel
 {
     GObject parent_instance;
 
-    gchar *name;
+    const gchar *name;
     GDateTime *release_date;
     gint64 size;
     gchar *version;
@@ -26,7 +26,6 @@ store_channel_dispose (GObject *object)
 {
     StoreChannel *self = STORE_CHANNEL (object);
 
-    g_clear_pointer (&self->name, g_free);
     g_clear_pointer (&self->release_date, g_date_time_unref);
     g_clear_pointer (&self->version, g_free);
 
@@ -42,7 +41,7 @@ store_channel_class_init (StoreChannelClass *klass)
 static void
 store_channel_init (StoreChannel *self)
 {
-    self->name = g_strdup ("");
+    self->name = g_intern_static_string ("");
     self->version = g_strdup ("");
 }
 
@@ -91,12 +90,27 @@ store_channel_to_json (StoreChannel *self)
     return json_builder_get_root (builder);
 }
 
+gboolean
+store_channel_equal (StoreChannel *channel1, StoreChannel *channel2)
+{
+    g_return_val_if_fail (STORE_IS_CHANNEL (channel1), FALSE);
+    g_return_val_if_fail (STORE_IS_CHANNEL (channel2), FALSE);
+
+    if (channel1->release_date != channel2->release_date &&
+        (channel1->release_date == NULL || channel2->release_date == NULL || !g_date_time_equal (channel1->release_date, channel2->release_date)))
+        return FALSE;
+
+    return channel1->name == channel2->name &&
+           channel1->size == channel2->size &&
+           g_strcmp0 (channel1->version, channel2->version) == 0;
+}
+
 void
 store_channel_set_name (StoreChannel *self, const gchar *name)
 {
     g_return_if_fail (STORE_IS_CHANNEL (self));
-    g_clear_pointer (&self->name, g_free);
-    self->name = g_strdup (name);
+    /* Channel names like "latest/stable" are shared by most snaps */
+    self->name = g_intern_string (name);
 }
 
 const gchar *
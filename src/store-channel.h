@@ -22,6 +22,8 @@ StoreChannel *store_channel_new_from_json    (JsonNode *node);
 
 JsonNode     *store_channel_to_json          (StoreChannel *channel);
 
+gboolean      store_channel_equal            (StoreChannel *channel1, StoreChannel *channel2);
+
 void          store_channel_set_name         (StoreChannel *channel, const gchar *name);
 
 const gchar  *store_channel_get_name         (StoreChannel *channel);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "store-diff.h"
+
+/* Largest number of item pairs to compare before giving up and replacing the whole changed range */
+#define MAX_DIFF_SIZE (1024 * 1024)
+
+static gboolean
+items_equal (GEqualFunc equal_func, gconstpointer a, gconstpointer b)
+{
+    return equal_func != NULL ? equal_func (a, b) : a == b;
+}
+
+static void
+add_change (GArray *changes, guint position, guint removed, guint added)
+{
+    if (removed == 0 && added == 0)
+        return;
+
+    StoreDiffChange change = { position, removed, added };
+    g_array_append_val (changes, change);
+}
+
+GArray *
+store_diff_ptr_arrays (GPtrArray *old_items, GPtrArray *new_items, GEqualFunc equal_func)
+{
+    g_autoptr(GArray) changes = g_array_new (FALSE, FALSE, sizeof (StoreDiffChange));
+
+    guint old_length = old_items != NULL ? old_items->len : 0;
+    guint new_length = new_items != NULL ? new_items->len : 0;
+
+    /* Most updates only touch a few items, so skip the common start and end */
+    guint prefix = 0;
+    while (prefix < old_length && prefix < new_length &&
+           items_equal (equal_func, g_ptr_array_index (old_items, prefix), g_ptr_array_index (new_items, prefix)))
+        prefix++;
+    guint suffix = 0;
+    while (suffix < old_length - prefix && suffix < new_length - prefix &&
+           items_equal (equal_func, g_ptr_array_index (old_items, old_length - suffix - 1), g_ptr_array_index (new_items, new_length - suffix - 1)))
+        suffix++;
+
+    guint n_old = old_length - prefix - suffix;
+    guint n_new = new_length - prefix - suffix;
+    if (n_old == 0 || n_new == 0 || (gsize) n_old * n_new > MAX_DIFF_SIZE) {
+        add_change (changes, prefix, n_old, n_new);
+        return g_steal_pointer (&changes);
+    }
+
+    /* Longest common subsequence of the remaining items, lengths[i][j] covers old[i:] and new[j:] */
+    guint stride = n_new + 1;
+    g_autofree guint *lengths = g_new0 (guint, (gsize) (n_old + 1) * stride);
+    for (guint i = n_old; i-- > 0;) {
+        for (guint j = n_new; j-- > 0;) {
+            if (items_equal (equal_func, g_ptr_array_index (old_items, prefix + i), g_ptr_array_index (new_items, prefix + j)))
+                lengths[i * stride + j] = lengths[(i + 1) * stride + j + 1] + 1;
+            else
+                lengths[i * stride + j] = MAX (lengths[(i + 1) * stride + j], lengths[i * stride + j + 1]);
+        }
+    }
+
+    /* Walk the common items, combining the gaps between them into changes */
+    guint position = prefix, removed = 0, added = 0;
+    guint i = 0, j = 0;
+    while (i < n_old || j < n_new) {
+        if (i < n_old && j < n_new &&
+            items_equal (equal_func, g_ptr_array_index (old_items, prefix + i), g_ptr_array_index (new_items, prefix + j))) {
+            add_change (changes, position, removed, added);
+            position += added + 1;
+            removed = added = 0;
+            i++;
+            j++;
+        }
+        else if (j < n_new && (i == n_old || lengths[i * stride + j + 1] >= lengths[(i + 1) * stride + j])) {
+            added++;
+            j++;
+        }
+        else {
+            removed++;
+            i++;
+        }
+    }
+    add_change (changes, position, removed, added);
+
+    return g_steal_pointer (&changes);
+}
+
+/* Changes @store to contain @items, only splicing the items that changed. Returns %TRUE if anything changed */
+gboolean
+store_diff_update_list_store (GListStore *store, GPtrArray *items)
+{
+    g_return_val_if_fail (G_IS_LIST_STORE (store), FALSE);
+
+    guint n_items = g_list_model_get_n_items (G_LIST_MODEL (store));
+    g_autoptr(GPtrArray) old_items = g_ptr_array_new_full (n_items, g_object_unref);
+    for (guint i = 0; i < n_items; i++)
+        g_ptr_array_add (old_items, g_list_model_get_item (G_LIST_MODEL (store), i));
+
+    /* Each change is relative to the ones before, so the added items are always in place in @items */
+    g_autoptr(GArray) changes = store_diff_ptr_arrays (old_items, items, NULL);
+    for (guint i = 0; i < changes->len; i++) {
+        StoreDiffChange *change = &g_array_index (changes, StoreDiffChange, i);
+        g_list_store_splice (store, change->position, change->removed, change->added > 0 ? items->pdata + change->position : NULL, change->added);
+    }
+
+    return changes->len > 0;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+/* Replace @removed items at @position with @added items, applied in order like GListModel::items-changed */
+typedef struct
+{
+    guint position;
+    guint removed;
+    guint added;
+} StoreDiffChange;
+
+GArray   *store_diff_ptr_arrays        (GPtrArray *old_items, GPtrArray *new_items, GEqualFunc equal_func);
+
+gboolean  store_diff_update_list_store (GListStore *store, GPtrArray *items);
+
+G_END_DECLS
@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <json-glib/json-glib.h>
+
+#include "store-frame-profiler.h"
+
+#include "store-trace.h"
+
+/* Time in milliseconds without a new frame after which a transition is considered finished */
+#define IDLE_TIMEOUT 250
+
+/* Longest time in milliseconds a transition is recorded for, in case something is animating */
+#define MAX_TRANSITION_TIME 5000
+
+/* Times are in microseconds */
+typedef struct
+{
+    gchar *detail;
+    gint64 duration;
+    gint64 first_frame_time;
+    gint64 frame_interval_max;
+    gint64 frame_time_max;
+    gint64 layout_time;
+    gint64 layout_time_max;
+    guint n_frames;
+    guint n_long_frames;
+    guint n_size_allocates;
+    guint n_widgets;
+    gchar *page;
+    gint64 paint_time;
+    gint64 paint_time_max;
+    gint64 setup_time;
+    gint64 start_time;
+} Transition;
+
+struct _StoreFrameProfiler
+{
+    GObject parent_instance;
+
+    Transition *current;
+    GdkFrameClock *frame_clock;
+    gint64 frame_start_time;
+    GSource *idle_source;
+    gint64 last_frame_time;
+    gint64 layout_start_time;
+    GtkWidget *page;
+    gint64 paint_start_time;
+    gulong size_allocate_hook;
+    StoreTraceSpan *span;
+    GPtrArray *transitions;
+};
+
+G_DEFINE_TYPE (StoreFrameProfiler, store_frame_profiler, G_TYPE_OBJECT)
+
+enum
+{
+    SIGNAL_TRANSITION_FINISHED,
+    SIGNAL_LAST
+};
+
+static guint signals[SIGNAL_LAST] = { 0 };
+
+static void
+transition_free (Transition *transition)
+{
+    g_free (transition->detail);
+    g_free (transition->page);
+    g_free (transition);
+}
+
+static void
+count_widgets_cb (GtkWidget *widget, gpointer user_data)
+{
+    guint *n_widgets = user_data;
+
+    (*n_widgets)++;
+    if (GTK_IS_CONTAINER (widget))
+        gtk_container_forall (GTK_CONTAINER (widget), count_widgets_cb, n_widgets);
+}
+
+static void
+finish_transition (StoreFrameProfiler *self)
+{
+    if (self->idle_source != NULL)
+        g_source_destroy (self->idle_source);
+    g_clear_pointer (&self->idle_source, g_source_unref);
+
+    Transition *transition = g_steal_pointer (&self->current);
+    if (transition == NULL)
+        return;
+
+    transition->duration = g_get_monotonic_time () - transition->start_time;
+    if (self->page != NULL)
+        count_widgets_cb (self->page, &transition->n_widgets);
+    g_clear_object (&self->page);
+    g_clear_pointer (&self->span, store_trace_end);
+
+    g_message ("%s%s%s: setup %.1fms, first frame %.1fms, %u frames (%u long, longest %.1fms), layout %.1fms (longest %.1fms), paint %.1fms (longest %.1fms), %u allocations, %u widgets",
+               transition->page,
+               transition->detail != NULL ? " " : "", transition->detail != NULL ? transition->detail : "",
+               transition->setup_time / 1000.0, transition->first_frame_time / 1000.0,
+               transition->n_frames, transition->n_long_frames, transition->frame_time_max / 1000.0,
+               transition->layout_time / 1000.0, transition->layout_time_max / 1000.0,
+               transition->paint_time / 1000.0, transition->paint_time_max / 1000.0,
+               transition->n_size_allocates, transition->n_widgets);
+
+    g_ptr_array_add (self->transitions, transition);
+}
+
+static gboolean
+idle_timeout_cb (gpointer user_data)
+{
+    StoreFrameProfiler *self = user_data;
+
+    finish_transition (self);
+    g_signal_emit (self, signals[SIGNAL_TRANSITION_FINISHED], 0);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+reset_idle_timeout (StoreFrameProfiler *self)
+{
+    if (self->idle_source != NULL)
+        g_source_destroy (self->idle_source);
+    g_clear_pointer (&self->idle_source, g_source_unref);
+    self->idle_source = g_timeout_source_new (IDLE_TIMEOUT);
+    g_source_set_callback (self->idle_source, idle_timeout_cb, self, NULL);
+    g_source_attach (self->idle_source, g_main_context_default ());
+}
+
+static void
+before_paint_cb (StoreFrameProfiler *self)
+{
+    self->frame_start_time = g_get_monotonic_time ();
+}
+
+/* Connected after, so runs once animations have been updated and layout is about to start */
+static void
+update_cb (StoreFrameProfiler *self)
+{
+    self->layout_start_time = g_get_monotonic_time ();
+}
+
+static void
+layout_cb (StoreFrameProfiler *self)
+{
+    gint64 now = g_get_monotonic_time ();
+
+    if (self->current != NULL && self->layout_start_time != 0) {
+        gint64 layout_time = now - self->layout_start_time;
+        self->current->layout_time += layout_time;
+        self->current->layout_time_max = MAX (self->current->layout_time_max, layout_time);
+    }
+    self->paint_start_time = now;
+}
+
+static void
+paint_cb (StoreFrameProfiler *self)
+{
+    if (self->current != NULL && self->paint_start_time != 0) {
+        gint64 paint_time = g_get_monotonic_time () - self->paint_start_time;
+        self->current->paint_time += paint_time;
+        self->current->paint_time_max = MAX (self->current->paint_time_max, paint_time);
+    }
+}
+
+static void
+after_paint_cb (StoreFrameProfiler *self, GdkFrameClock *frame_clock)
+{
+    Transition *transition = self->current;
+    if (transition == NULL)
+        return;
+
+    gint64 now = g_get_monotonic_time ();
+
+    if (transition->n_frames == 0) {
+        transition->setup_time = MAX (self->frame_start_time - transition->start_time, 0);
+        transition->first_frame_time = now - transition->start_time;
+    }
+    else
+        transition->frame_interval_max = MAX (transition->frame_interval_max, now - self->last_frame_time);
+    transition->n_frames++;
+    self->last_frame_time = now;
+
+    /* A frame is long if it took more than the refresh interval to produce, i.e. missed a vblank */
+    gint64 frame_time = now - self->frame_start_time;
+    transition->frame_time_max = MAX (transition->frame_time_max, frame_time);
+    gint64 refresh_interval = 0;
+    gdk_frame_clock_get_refresh_info (frame_clock, gdk_frame_clock_get_frame_time (frame_clock), &refresh_interval, NULL);
+    if (refresh_interval > 0 && frame_time > refresh_interval)
+        transition->n_long_frames++;
+
+    if (now - transition->start_time >= MAX_TRANSITION_TIME * 1000) {
+        finish_transition (self);
+        g_signal_emit (self, signals[SIGNAL_TRANSITION_FINISHED], 0);
+        return;
+    }
+
+    reset_idle_timeout (self);
+}
+
+static gboolean
+size_allocate_hook_cb (GSignalInvocationHint *hint G_GNUC_UNUSED, guint n_values G_GNUC_UNUSED, const GValue *values G_GNUC_UNUSED, gpointer user_data)
+{
+    StoreFrameProfiler *self = user_data;
+
+    if (self->current != NULL)
+        self->current->n_size_allocates++;
+
+    return TRUE;
+}
+
+static void
+set_frame_clock (StoreFrameProfiler *self, GdkFrameClock *frame_clock)
+{
+    if (self->frame_clock == frame_clock)
+        return;
+
+    if (self->frame_clock != NULL)
+        g_signal_handlers_disconnect_by_data (self->frame_clock, self);
+    g_set_object (&self->frame_clock, frame_clock);
+    if (frame_clock == NULL)
+        return;
+
+    /* Connected after GTK's handlers so the times cover the work they do in each phase */
+    g_signal_connect_object (frame_clock, "before-paint", G_CALLBACK (before_paint_cb), self, G_CONNECT_SWAPPED);
+    g_signal_connect_object (frame_clock, "update", G_CALLBACK (update_cb), self, G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+    g_signal_connect_object (frame_clock, "layout", G_CALLBACK (layout_cb), self, G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+    g_signal_connect_object (frame_clock, "paint", G_CALLBACK (paint_cb), self, G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+    g_signal_connect_object (frame_clock, "after-paint", G_CALLBACK (after_paint_cb), self, G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+}
+
+static void
+store_frame_profiler_dispose (GObject *object)
+{
+    StoreFrameProfiler *self = STORE_FRAME_PROFILER (object);
+
+    if (self->size_allocate_hook != 0)
+        g_signal_remove_emission_hook (g_signal_lookup ("size-allocate", GTK_TYPE_WIDGET), self->size_allocate_hook);
+    self->size_allocate_hook = 0;
+    g_clear_pointer (&self->current, transition_free);
+    set_frame_clock (self, NULL);
+    if (self->idle_source != NULL)
+        g_source_destroy (self->idle_source);
+    g_clear_pointer (&self->idle_source, g_source_unref);
+    g_clear_object (&self->page);
+    g_clear_pointer (&self->span, store_trace_end);
+    g_clear_pointer (&self->transitions, g_ptr_array_unref);
+
+    G_OBJECT_CLASS (store_frame_profiler_parent_class)->dispose (object);
+}
+
+static void
+store_frame_profiler_class_init (StoreFrameProfilerClass *klass)
+{
+    G_OBJECT_CLASS (klass)->dispose = store_frame_profiler_dispose;
+
+    signals[SIGNAL_TRANSITION_FINISHED] = g_signal_new ("transition-finished",
+                                                        G_TYPE_FROM_CLASS (G_OBJECT_CLASS (klass)),
+                                                        G_SIGNAL_RUN_LAST,
+                                                        0,
+                                                        NULL, NULL,
+                                                        NULL,
+                                                        G_TYPE_NONE,
+                                                        0);
+}
+
+static void
+store_frame_profiler_init (StoreFrameProfiler *self)
+{
+    self->transitions = g_ptr_array_new_with_free_func ((GDestroyNotify) transition_free);
+
+    self->size_allocate_hook = g_signal_add_emission_hook (g_signal_lookup ("size-allocate", GTK_TYPE_WIDGET), 0, size_allocate_hook_cb, self, NULL);
+}
+
+StoreFrameProfiler *
+store_frame_profiler_new (void)
+{
+    return g_object_new (store_frame_profiler_get_type (), NULL);
+}
+
+/* Start recording a switch to @page, before any work is done to set it up. Any transition still being recorded is finished */
+void
+store_frame_profiler_begin_transition (StoreFrameProfiler *self, GtkWidget *page, const gchar *detail)
+{
+    g_return_if_fail (STORE_IS_FRAME_PROFILER (self));
+    g_return_if_fail (GTK_IS_WIDGET (page));
+
+    finish_transition (self);
+
+    Transition *transition = g_new0 (Transition, 1);
+    transition->detail = g_strdup (detail);
+    transition->page = g_strdup (G_OBJECT_TYPE_NAME (page));
+    transition->start_time = g_get_monotonic_time ();
+    self->current = transition;
+    g_set_object (&self->page, page);
+    self->last_frame_time = 0;
+    self->layout_start_time = 0;
+    self->paint_start_time = 0;
+    self->span = store_trace_begin_async ("window", "transition", transition->page);
+
+    /* The page may not have been realized yet, but will share the frame clock of the window */
+    set_frame_clock (self, gtk_widget_get_frame_clock (gtk_widget_get_toplevel (page)));
+    /* Finishes even if nothing is drawn */
+    reset_idle_timeout (self);
+}
+
+gboolean
+store_frame_profiler_write (StoreFrameProfiler *self, const gchar *path, GError **error)
+{
+    g_return_val_if_fail (STORE_IS_FRAME_PROFILER (self), FALSE);
+
+    g_autoptr(JsonBuilder) builder = json_builder_new ();
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "transitions");
+    json_builder_begin_array (builder);
+    for (guint i = 0; i < self->transitions->len; i++) {
+        Transition *transition = g_ptr_array_index (self->transitions, i);
+
+        json_builder_begin_object (builder);
+        json_builder_set_member_name (builder, "page");
+        json_builder_add_string_value (builder, transition->page);
+        if (transition->detail != NULL) {
+            json_builder_set_member_name (builder, "detail");
+            json_builder_add_string_value (builder, transition->detail);
+        }
+        json_builder_set_member_name (builder, "duration");
+        json_builder_add_int_value (builder, transition->duration);
+        json_builder_set_member_name (builder, "setup-time");
+        json_builder_add_int_value (builder, transition->setup_time);
+        json_builder_set_member_name (builder, "first-frame-time");
+        json_builder_add_int_value (builder, transition->first_frame_time);
+        json_builder_set_member_name (builder, "n-frames");
+        json_builder_add_int_value (builder, transition->n_frames);
+        json_builder_set_member_name (builder, "n-long-frames");
+        json_builder_add_int_value (builder, transition->n_long_frames);
+        json_builder_set_member_name (builder, "frame-time-max");
+        json_builder_add_int_value (builder, transition->frame_time_max);
+        json_builder_set_member_name (builder, "frame-interval-max");
+        json_builder_add_int_value (builder, transition->frame_interval_max);
+        json_builder_set_member_name (builder, "layout-time");
+        json_builder_add_int_value (builder, transition->layout_time);
+        json_builder_set_member_name (builder, "layout-time-max");
+        json_builder_add_int_value (builder, transition->layout_time_max);
+        json_builder_set_member_name (builder, "paint-time");
+        json_builder_add_int_value (builder, transition->paint_time);
+        json_builder_set_member_name (builder, "paint-time-max");
+        json_builder_add_int_value (builder, transition->paint_time_max);
+        json_builder_set_member_name (builder, "n-size-allocates");
+        json_builder_add_int_value (builder, transition->n_size_allocates);
+        json_builder_set_member_name (builder, "n-widgets");
+        json_builder_add_int_value (builder, transition->n_widgets);
+        json_builder_end_object (builder);
+    }
+    json_builder_end_array (builder);
+    json_builder_end_object (builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new ();
+    g_autoptr(JsonNode) root = json_builder_get_root (builder);
+    json_generator_set_root (generator, root);
+    return json_generator_to_file (generator, path, error);
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE (StoreFrameProfiler, store_frame_profiler, STORE, FRAME_PROFILER, GObject)
+
+StoreFrameProfiler *store_frame_profiler_new              (void);
+
+void                store_frame_profiler_begin_transition (StoreFrameProfiler *profiler, GtkWidget *page, const gchar *detail);
+
+gboolean            store_frame_profiler_write            (StoreFrameProfiler *profiler, const gchar *path, GError **error);
+
+G_END_DECLS
@@ -34,6 +34,8 @@ struct _StoreHomePage
 
     StoreCategory *featured_category;
     GCancellable *search_cancellable;
+    gchar *search_query;
+    GPtrArray *search_results;
     GSource *search_timeout;
 };
 
@@ -87,6 +89,8 @@ search_results_cb (GObject *object, GAsyncResult *result, gpointer user_data)
         return;
     }
 
+    g_clear_pointer (&self->search_results, g_ptr_array_unref);
+    self->search_results = g_ptr_array_ref (apps);
     store_app_grid_set_apps (self->search_results_grid, apps);
 
     gtk_widget_hide (GTK_WIDGET (self->category_box));
@@ -111,9 +115,25 @@ search_cb (StoreHomePage *self)
     g_cancellable_cancel (self->search_cancellable);
     g_clear_object (&self->search_cancellable);
     self->search_cancellable = g_cancellable_new ();
+    g_free (self->search_query);
+    self->search_query = g_strdup (query);
     store_model_search_async (store_page_get_model (STORE_PAGE (self)), query, self->search_cancellable, search_results_cb, self);
 }
 
+static void
+search_results_end_reached_cb (StoreHomePage *self)
+{
+    StoreModel *model = store_page_get_model (STORE_PAGE (self));
+    if (self->search_results == NULL || !store_model_get_has_more_search_results (model, self->search_query, self->search_results->len))
+        return;
+
+    /* Add the next page of results when scrolled to the end */
+    g_autoptr(GPtrArray) apps = store_model_get_more_search_results (model, self->search_query, self->search_results->len);
+    for (guint i = 0; i < apps->len; i++)
+        g_ptr_array_add (self->search_results, g_object_ref (g_ptr_array_index (apps, i)));
+    store_app_grid_set_apps (self->search_results_grid, self->search_results);
+}
+
 static gboolean
 search_timeout_cb (gpointer user_data)
 {
@@ -149,6 +169,8 @@ store_home_page_dispose (GObject *object)
     g_cancellable_cancel (self->search_cancellable);
     g_clear_object (&self->search_cancellable);
     g_clear_object (&self->featured_category);
+    g_clear_pointer (&self->search_query, g_free);
+    g_clear_pointer (&self->search_results, g_ptr_array_unref);
     if (self->search_timeout)
         g_source_destroy (self->search_timeout);
     g_clear_pointer (&self->search_timeout, g_source_unref);
@@ -230,6 +252,7 @@ store_home_page_class_init (StoreHomePageClass *klass)
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), category_list_activated_cb);
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), search_cb);
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), search_changed_cb);
+    gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), search_results_end_reached_cb);
     gtk_widget_class_bind_template_callback (GTK_WIDGET_CLASS (klass), see_more_editors_picks_cb);
 
     signals[SIGNAL_APP_ACTIVATED] = g_signal_new ("app-activated",
@@ -280,6 +303,7 @@ store_home_page_set_categories (StoreHomePage *self, GPtrArray *categories)
             for (guint i = 0; i < apps->len && i < 6; i++) {
                 StoreSnapApp *app = g_ptr_array_index (apps, i);
                 g_ptr_array_add (featured_apps, g_object_ref (app));
+                store_model_prefetch_reviews (store_page_get_model (STORE_PAGE (self)), STORE_APP (app));
             }
             store_app_grid_set_apps (self->editors_picks_grid, featured_apps);
             continue;
@@ -300,11 +324,8 @@ store_home_page_load (StoreHomePage *self)
 {
     store_model_update_categories_async (store_page_get_model (STORE_PAGE (self)), NULL, NULL, NULL);
 
-    // FIXME: Hardcoded
-    g_autoptr(StoreSnapApp) app = store_model_get_snap (store_page_get_model (STORE_PAGE (self)), "telemetrytv");
-    store_banner_tile_set_app (self->banner_tile, STORE_APP (app));
-    g_autoptr(StoreSnapApp) app1 = store_model_get_snap (store_page_get_model (STORE_PAGE (self)), "supertuxkart");
-    store_banner_tile_set_app (self->banner1_tile, STORE_APP (app1));
-    g_autoptr(StoreSnapApp) app2 = store_model_get_snap (store_page_get_model (STORE_PAGE (self)), "fluffychat");
-    store_banner_tile_set_app (self->banner2_tile, STORE_APP (app2));
+    StoreBannerTile *banner_tiles[] = { self->banner_tile, self->banner1_tile, self->banner2_tile };
+    g_autoptr(GPtrArray) banner_apps = store_model_get_banner_apps (store_page_get_model (STORE_PAGE (self)));
+    for (guint i = 0; i < banner_apps->len && i < G_N_ELEMENTS (banner_tiles); i++)
+        store_banner_tile_set_app (banner_tiles[i], g_ptr_array_index (banner_apps, i));
 }
@@ -12,6 +12,7 @@
 #include "store-app.h"
 #include "store-app-installed-tile.h"
 #include "store-installed-page.h"
+#include "store-tile-reconciler.h"
 
 struct _StoreInstalledPage
 {
@@ -21,16 +22,9 @@ struct _StoreInstalledPage
     GtkLabel *count_label;
 
     GCancellable *cancellable;
+    StoreTileReconciler *reconciler;
 };
 
-enum
-{
-    PROP_0,
-    PROP_APPS,
-    PROP_LAST
-};
-
-
 G_DEFINE_TYPE (StoreInstalledPage, store_installed_page, store_page_get_type ())
 
 enum
@@ -54,45 +48,37 @@ store_installed_page_dispose (GObject *object)
 
     g_cancellable_cancel (self->cancellable);
     g_clear_object (&self->cancellable);
+    g_clear_object (&self->reconciler);
 
     G_OBJECT_CLASS (store_installed_page_parent_class)->dispose (object);
 }
 
-static gboolean
-installed_count_to_label (GBinding *binding G_GNUC_UNUSED, const GValue *from_value, GValue *to_value, gpointer user_data G_GNUC_UNUSED)
+static void
+update_count_label (StoreInstalledPage *self, GListModel *apps)
 {
-    GPtrArray *apps = g_value_get_boxed (from_value);
-
+    guint n_apps = g_list_model_get_n_items (apps);
     g_autofree gchar *text = g_strdup_printf (ngettext (/* Text shown above the list of installed applications */
                                                         "You have %d installed application…",
-                                                        "You have %d installed applications…", apps->len), apps->len);
-
-    g_value_set_string (to_value, text);
-
-    return TRUE;
+                                                        "You have %d installed applications…", n_apps), n_apps);
+    gtk_label_set_label (self->count_label, text);
 }
 
-
-static void
-store_installed_page_get_property (GObject *object, guint prop_id, GValue *value G_GNUC_UNUSED, GParamSpec *pspec)
+static GtkWidget *
+new_tile_cb (StoreInstalledPage *self)
 {
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    StoreAppInstalledTile *tile = store_app_installed_tile_new ();
+    gtk_widget_show (GTK_WIDGET (tile));
+    g_signal_connect_object (tile, "activated", G_CALLBACK (tile_activated_cb), self, G_CONNECT_SWAPPED);
+    store_app_installed_tile_set_model (tile, store_page_get_model (STORE_PAGE (self)));
+    return GTK_WIDGET (tile);
 }
 
+/* Only create and remove the tiles for apps that changed */
 static void
-store_installed_page_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+items_changed_cb (StoreInstalledPage *self, guint position G_GNUC_UNUSED, guint removed G_GNUC_UNUSED, guint added G_GNUC_UNUSED, GListModel *apps)
 {
-    StoreInstalledPage *self = STORE_INSTALLED_PAGE (object);
-
-    switch (prop_id)
-    {
-    case PROP_APPS:
-        store_installed_page_set_apps (self, g_value_get_boxed (value));
-        break;
-    default:
-        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
-        break;
-    }
+    store_tile_reconciler_update_box (self->reconciler, self->app_box, apps, G_MAXUINT);
+    update_count_label (self, apps);
 }
 
 static void
@@ -102,24 +88,24 @@ store_installed_page_set_model (StorePage *page, StoreModel *model)
 
     // FIXME: Should apply to children
 
-    g_object_bind_property (model, "installed", self, "apps", G_BINDING_SYNC_CREATE);
-    g_object_bind_property_full (model, "installed", self->count_label, "label", G_BINDING_SYNC_CREATE, installed_count_to_label, NULL, NULL, NULL);
+    StoreModel *old_model = store_page_get_model (page);
+    if (old_model != NULL)
+        g_signal_handlers_disconnect_by_func (store_model_get_installed_list (old_model), items_changed_cb, self);
 
     STORE_PAGE_CLASS (store_installed_page_parent_class)->set_model (page, model);
+
+    GListModel *apps = store_model_get_installed_list (model);
+    g_signal_connect_object (apps, "items-changed", G_CALLBACK (items_changed_cb), self, G_CONNECT_SWAPPED);
+    gtk_container_foreach (GTK_CONTAINER (self->app_box), (GtkCallback) gtk_widget_destroy, NULL);
+    items_changed_cb (self, 0, 0, 0, apps);
 }
 
 static void
 store_installed_page_class_init (StoreInstalledPageClass *klass)
 {
     G_OBJECT_CLASS (klass)->dispose = store_installed_page_dispose;
-    G_OBJECT_CLASS (klass)->get_property = store_installed_page_get_property;
-    G_OBJECT_CLASS (klass)->set_property = store_installed_page_set_property;
     STORE_PAGE_CLASS (klass)->set_model = store_installed_page_set_model;
 
-    g_object_class_install_property (G_OBJECT_CLASS (klass),
-                                     PROP_APPS,
-                                     g_param_spec_boxed ("apps", NULL, NULL, G_TYPE_PTR_ARRAY, G_PARAM_WRITABLE));
-
     gtk_widget_class_set_template_from_resource (GTK_WIDGET_CLASS (klass), "/io/snapcraft/Store/store-installed-page.ui");
 
     gtk_widget_class_bind_template_child (GTK_WIDGET_CLASS (klass), StoreInstalledPage, app_box);
@@ -139,6 +125,10 @@ static void
 store_installed_page_init (StoreInstalledPage *self)
 {
     self->cancellable = g_cancellable_new ();
+    self->reconciler = store_tile_reconciler_new ((StoreTileNewFunc) new_tile_cb,
+                                                  (StoreTileGetItemFunc) store_app_installed_tile_get_app,
+                                                  (StoreTileSetItemFunc) store_app_installed_tile_set_app,
+                                                  self);
 
     store_page_get_type ();
     gtk_widget_init_template (GTK_WIDGET (self));
@@ -151,34 +141,3 @@ store_installed_page_load (StoreInstalledPage *self)
 
     store_model_update_installed_async (store_page_get_model (STORE_PAGE (self)), NULL, NULL, NULL);
 }
-
-void
-store_installed_page_set_apps (StoreInstalledPage *self, GPtrArray *apps)
-{
-    g_return_if_fail (STORE_IS_INSTALLED_PAGE (self));
-
-    /* Ensure correct number of app tiles */
-    g_autoptr(GList) children = gtk_container_get_children (GTK_CONTAINER (self->app_box));
-    guint n_tiles = g_list_length (children);
-    while (n_tiles < apps->len) {
-        StoreAppInstalledTile *tile = store_app_installed_tile_new ();
-        gtk_widget_show (GTK_WIDGET (tile));
-        g_signal_connect_object (tile, "activated", G_CALLBACK (tile_activated_cb), self, G_CONNECT_SWAPPED);
-        store_app_installed_tile_set_model (tile, store_page_get_model (STORE_PAGE (self)));
-        gtk_container_add (GTK_CONTAINER (self->app_box), GTK_WIDGET (tile));
-        n_tiles++;
-        children = g_list_append (children, tile);
-    }
-    while (n_tiles > apps->len) {
-        for (GList *link = g_list_nth (children, apps->len); link != NULL; link = link->next) {
-            StoreAppInstalledTile *tile = link->data;
-            gtk_container_remove (GTK_CONTAINER (self->app_box), GTK_WIDGET (tile));
-        }
-    }
-
-    for (guint i = 0; i < apps->len; i++) {
-        StoreSnapApp *app = g_ptr_array_index (apps, i);
-        StoreAppInstalledTile *tile = g_list_nth_data (children, i);
-        store_app_installed_tile_set_app (tile, STORE_APP (app));
-    }
-}
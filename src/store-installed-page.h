@@ -15,8 +15,6 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (StoreInstalledPage, store_installed_page, STORE, INSTALLED_PAGE, StorePage)
 
-void store_installed_page_load     (StoreInstalledPage *page);
-
-void store_installed_page_set_apps (StoreInstalledPage *page, GPtrArray *apps);
+void store_installed_page_load (StoreInstalledPage *page);
 
 G_END_DECLS
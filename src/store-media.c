@@ -86,6 +86,17 @@ store_media_to_json (StoreMedia *self)
     return json_builder_get_root (builder);
 }
 
+gboolean
+store_media_equal (StoreMedia *media1, StoreMedia *media2)
+{
+    g_return_val_if_fail (STORE_IS_MEDIA (media1), FALSE);
+    g_return_val_if_fail (STORE_IS_MEDIA (media2), FALSE);
+
+    return media1->height == media2->height &&
+           media1->width == media2->width &&
+           g_strcmp0 (media1->uri, media2->uri) == 0;
+}
+
 void
 store_media_set_height (StoreMedia *self, guint height)
 {
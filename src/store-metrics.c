@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "store-metrics.h"
+
+/* Number of recent searches the search time percentiles are calculated from */
+#define SEARCH_TIMES_LENGTH 100
+
+typedef struct
+{
+    guint64 bytes_read;
+    guint64 bytes_written;
+    guint64 hits;
+    guint64 misses;
+} CacheMetrics;
+
+/* Names the counters are exported with, in the same order as StoreMetric */
+static const gchar *metric_names[STORE_METRIC_LAST] =
+{
+    "decoded-image-bytes",
+    "http-requests",
+    "image-queue-length",
+    "registry-size",
+    "snapd-requests"
+};
+
+static GHashTable *cache_metrics = NULL;
+static GMutex metrics_mutex;
+static guint64 n_searches = 0;
+static gint64 search_time_max = 0;
+static gint64 search_time_total = 0;
+static gint64 search_times[SEARCH_TIMES_LENGTH];
+static gint64 values[STORE_METRIC_LAST] = { 0 };
+
+/* Must be called with metrics_mutex held */
+static CacheMetrics *
+get_cache_metrics (const gchar *type)
+{
+    if (cache_metrics == NULL)
+        cache_metrics = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+    CacheMetrics *metrics = g_hash_table_lookup (cache_metrics, type);
+    if (metrics == NULL) {
+        metrics = g_new0 (CacheMetrics, 1);
+        g_hash_table_insert (cache_metrics, g_strdup (type), metrics);
+    }
+
+    return metrics;
+}
+
+static int
+compare_times (const void *a, const void *b)
+{
+    gint64 time_a = *(const gint64 *) a, time_b = *(const gint64 *) b;
+    return time_a < time_b ? -1 : time_a > time_b ? 1 : 0;
+}
+
+static gint64
+get_percentile (gint64 *times, guint n_times, guint percentile)
+{
+    if (n_times == 0)
+        return 0;
+    guint rank = (percentile * n_times + 99) / 100;
+    return times[MAX (rank, 1) - 1];
+}
+
+/* Counters can be updated from any thread */
+void
+store_metrics_add (StoreMetric metric, gint64 delta)
+{
+    g_return_if_fail (metric < STORE_METRIC_LAST);
+
+    g_mutex_lock (&metrics_mutex);
+    values[metric] += delta;
+    g_mutex_unlock (&metrics_mutex);
+}
+
+static void
+image_weak_notify_cb (gpointer user_data, GObject *where_the_object_was G_GNUC_UNUSED)
+{
+    store_metrics_add (STORE_METRIC_DECODED_IMAGE_BYTES, -(gint64) GPOINTER_TO_SIZE (user_data));
+}
+
+/* Count the memory used by a decoded image until it is freed */
+void
+store_metrics_add_image (GObject *image, gsize n_bytes)
+{
+    g_return_if_fail (G_IS_OBJECT (image));
+
+    store_metrics_add (STORE_METRIC_DECODED_IMAGE_BYTES, n_bytes);
+    g_object_weak_ref (image, image_weak_notify_cb, GSIZE_TO_POINTER (n_bytes));
+}
+
+void
+store_metrics_add_cache_lookup (const gchar *type, gboolean hit, gsize n_bytes)
+{
+    g_mutex_lock (&metrics_mutex);
+    CacheMetrics *metrics = get_cache_metrics (type);
+    if (hit) {
+        metrics->hits++;
+        metrics->bytes_read += n_bytes;
+    }
+    else
+        metrics->misses++;
+    g_mutex_unlock (&metrics_mutex);
+}
+
+void
+store_metrics_add_cache_write (const gchar *type, gsize n_bytes)
+{
+    g_mutex_lock (&metrics_mutex);
+    get_cache_metrics (type)->bytes_written += n_bytes;
+    g_mutex_unlock (&metrics_mutex);
+}
+
+/* Time in microseconds a search took to be answered by snapd */
+void
+store_metrics_add_search_time (gint64 time)
+{
+    g_mutex_lock (&metrics_mutex);
+    search_times[n_searches % SEARCH_TIMES_LENGTH] = time;
+    n_searches++;
+    search_time_max = MAX (search_time_max, time);
+    search_time_total += time;
+    g_mutex_unlock (&metrics_mutex);
+}
+
+static void
+request_queued_cb (SoupSession *session G_GNUC_UNUSED, SoupMessage *message G_GNUC_UNUSED)
+{
+    store_metrics_add (STORE_METRIC_HTTP_REQUESTS, 1);
+}
+
+static void
+request_unqueued_cb (SoupSession *session G_GNUC_UNUSED, SoupMessage *message G_GNUC_UNUSED)
+{
+    store_metrics_add (STORE_METRIC_HTTP_REQUESTS, -1);
+}
+
+/* Count the HTTP requests in progress in @session */
+void
+store_metrics_watch_soup_session (SoupSession *session)
+{
+    g_return_if_fail (SOUP_IS_SESSION (session));
+
+    g_signal_connect (session, "request-queued", G_CALLBACK (request_queued_cb), NULL);
+    g_signal_connect (session, "request-unqueued", G_CALLBACK (request_unqueued_cb), NULL);
+}
+
+/* Returns the current values as a floating a{sv}. Times are in microseconds */
+GVariant *
+store_metrics_get_variant (void)
+{
+    GVariantBuilder builder;
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+
+    g_mutex_lock (&metrics_mutex);
+
+    for (guint i = 0; i < STORE_METRIC_LAST; i++)
+        g_variant_builder_add (&builder, "{sv}", metric_names[i], g_variant_new_int64 (values[i]));
+
+    GVariantBuilder cache_builder;
+    g_variant_builder_init (&cache_builder, G_VARIANT_TYPE ("a{sa{st}}"));
+    if (cache_metrics != NULL) {
+        GHashTableIter iter;
+        g_hash_table_iter_init (&iter, cache_metrics);
+        gpointer key, value;
+        while (g_hash_table_iter_next (&iter, &key, &value)) {
+            CacheMetrics *metrics = value;
+
+            g_variant_builder_open (&cache_builder, G_VARIANT_TYPE ("{sa{st}}"));
+            g_variant_builder_add (&cache_builder, "s", key);
+            g_variant_builder_open (&cache_builder, G_VARIANT_TYPE ("a{st}"));
+            g_variant_builder_add (&cache_builder, "{st}", "hits", metrics->hits);
+            g_variant_builder_add (&cache_builder, "{st}", "misses", metrics->misses);
+            g_variant_builder_add (&cache_builder, "{st}", "bytes-read", metrics->bytes_read);
+            g_variant_builder_add (&cache_builder, "{st}", "bytes-written", metrics->bytes_written);
+            g_variant_builder_close (&cache_builder);
+            g_variant_builder_close (&cache_builder);
+        }
+    }
+    g_variant_builder_add (&builder, "{sv}", "cache", g_variant_builder_end (&cache_builder));
+
+    guint n_times = MIN (n_searches, SEARCH_TIMES_LENGTH);
+    gint64 times[SEARCH_TIMES_LENGTH];
+    memcpy (times, search_times, n_times * sizeof (gint64));
+    qsort (times, n_times, sizeof (gint64), compare_times);
+    g_variant_builder_add (&builder, "{sv}", "searches", g_variant_new_uint64 (n_searches));
+    g_variant_builder_add (&builder, "{sv}", "search-time-mean", g_variant_new_int64 (n_searches > 0 ? search_time_total / (gint64) n_searches : 0));
+    g_variant_builder_add (&builder, "{sv}", "search-time-median", g_variant_new_int64 (get_percentile (times, n_times, 50)));
+    g_variant_builder_add (&builder, "{sv}", "search-time-p95", g_variant_new_int64 (get_percentile (times, n_times, 95)));
+    g_variant_builder_add (&builder, "{sv}", "search-time-max", g_variant_new_int64 (search_time_max));
+
+    g_mutex_unlock (&metrics_mutex);
+
+    return g_variant_builder_end (&builder);
+}
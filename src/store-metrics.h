@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+#include <libsoup/soup.h>
+
+G_BEGIN_DECLS
+
+typedef enum
+{
+    STORE_METRIC_DECODED_IMAGE_BYTES,
+    STORE_METRIC_HTTP_REQUESTS,
+    STORE_METRIC_IMAGE_QUEUE_LENGTH,
+    STORE_METRIC_REGISTRY_SIZE,
+    STORE_METRIC_SNAPD_REQUESTS,
+    STORE_METRIC_LAST
+} StoreMetric;
+
+void      store_metrics_add                (StoreMetric metric, gint64 delta);
+
+void      store_metrics_add_image          (GObject *image, gsize n_bytes);
+
+void      store_metrics_add_cache_lookup   (const gchar *type, gboolean hit, gsize n_bytes);
+
+void      store_metrics_add_cache_write    (const gchar *type, gsize n_bytes);
+
+void      store_metrics_add_search_time    (gint64 time);
+
+void      store_metrics_watch_soup_session (SoupSession *session);
+
+GVariant *store_metrics_get_variant        (void);
+
+G_END_DECLS
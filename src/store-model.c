@@ -11,20 +11,103 @@
 #include <libsoup/soup.h>
 #include <snapd-glib/snapd-glib.h>
 
+#include "store-diff.h"
+#include "store-metrics.h"
 #include "store-model.h"
 #include "store-odrs-client.h"
+#include "store-trace.h"
+
+/* Number of recently used snaps kept alive after nothing else references them */
+#define RECENT_SNAPS_LENGTH 64
+
+/* Number of recent searches to keep the results of */
+#define RECENT_SEARCHES_LENGTH 20
+
+/* Default time in seconds before checking for new ratings */
+#define DEFAULT_RATINGS_MAX_AGE (24 * 60 * 60)
+
+/* Time in seconds to wait for more new apps before downloading filtered ratings again */
+#define RATINGS_FILTER_DELAY 5
+
+/* Number of reviews to request at a time */
+#define REVIEWS_PAGE_SIZE 20
+
+/* Maximum number of review requests to make in the background at once */
+#define MAX_REVIEW_PREFETCHES 2
+
+/* Number of apps to show at a time in categories and search results */
+#define APPS_PAGE_SIZE 30
+
+/* Time in seconds between checking snapd for completed changes */
+#define CHANGES_POLL_INTERVAL 10
+
+/* Number of apps in each category saved in the home page snapshot */
+#define HOME_SNAPSHOT_APPS 6
+
+/* Time in seconds to wait after a refresh before saving the home page snapshot */
+#define SNAPSHOT_SAVE_DELAY 2
+
+// FIXME: Hardcoded
+static const gchar *banner_names[] = { "telemetrytv", "supertuxkart", "fluffychat", NULL };
+
+/* Kinds of data that are served from cache and revalidated against snapd / ODRS */
+typedef enum
+{
+    DATA_KIND_CATEGORIES,
+    DATA_KIND_CATEGORY_APPS,
+    DATA_KIND_INSTALLED,
+    DATA_KIND_REVIEWS,
+    DATA_KIND_SEARCH,
+    DATA_KIND_SNAP
+} DataKind;
+
+/* Time in seconds each kind of data is considered fresh, and where it is stored on disk */
+static const struct
+{
+    const gchar *name;
+    gint64 max_age;
+    const gchar *cache_type;
+} data_kinds[] =
+{
+    { "categories",    60 * 60, "sections" },
+    { "category-apps", 60 * 60, "sections" },
+    { "installed",     5 * 60,  NULL },
+    { "reviews",       60 * 60, "reviews" },
+    { "search",        10 * 60, NULL },
+    { "snap",          60 * 60, "snaps" }
+};
 
 struct _StoreModel
 {
     GObject parent_instance;
 
     StoreCache *cache;
+    GHashTable *cache_times;
+    GCancellable *cancellable;
     GPtrArray *categories;
+    GListStore *category_list;
+    GHashTable *category_results;
+    gboolean changes_polling;
+    GSource *changes_source;
+    gboolean filter_ratings;
     GPtrArray *installed;
+    GListStore *installed_list;
+    guint n_review_prefetches;
     StoreOdrsClient *odrs_client;
+    GHashTable *rating_ids;
+    gboolean ratings_filtered;
+    gint64 ratings_max_age;
+    GSource *ratings_source;
+    GHashTable *ready_changes;
+    GQueue *recent_searches;
+    GQueue *recent_snaps;
+    GQueue *review_prefetch_queue;
+    GHashTable *search_results;
     SoupSession *session;
     gchar *snapd_socket_path;
     GHashTable *snaps;
+    GSource *snapshot_source;
+    GHashTable *validated;
 };
 
 enum
@@ -41,6 +124,7 @@ typedef struct
 {
     StoreModel *self;
     gchar *section_name;
+    StoreTraceSpan *span;
 } FindSectionData;
 
 static FindSectionData *
@@ -49,6 +133,7 @@ find_section_data_new (StoreModel *self, const gchar *section_name)
     FindSectionData *data = g_new0 (FindSectionData, 1);
     data->self = self;
     data->section_name = g_strdup (section_name);
+    data->span = store_trace_begin_async ("snapd", "find-section", section_name);
     return data;
 }
 
@@ -56,11 +141,112 @@ static void
 find_section_data_free (FindSectionData *data)
 {
     g_free (data->section_name);
+    store_trace_end (data->span);
     g_free (data);
 }
 
 G_DEFINE_AUTOPTR_CLEANUP_FUNC (FindSectionData, find_section_data_free)
 
+typedef struct
+{
+    StoreModel *self;
+    gchar *name;
+    StoreTraceSpan *span;
+} GetSnapData;
+
+static GetSnapData *
+get_snap_data_new (StoreModel *self, const gchar *name)
+{
+    GetSnapData *data = g_new0 (GetSnapData, 1);
+    data->self = self;
+    data->name = g_strdup (name);
+    data->span = store_trace_begin_async ("snapd", "get-snap", name);
+    return data;
+}
+
+static void
+get_snap_data_free (GetSnapData *data)
+{
+    g_free (data->name);
+    store_trace_end (data->span);
+    g_free (data);
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GetSnapData, get_snap_data_free)
+
+/* Weak entry in the snap registry, removed when the snap is no longer used */
+typedef struct
+{
+    StoreModel *self;
+    gchar *name;
+    StoreSnapApp *snap;
+    gboolean hydrated;
+    gint64 hydrated_time;
+    gboolean details_hydrated;
+    gboolean reviews_complete;
+    gboolean reviews_fetched;
+    gboolean reviews_queued;
+} SnapRef;
+
+static void
+snap_ref_free (SnapRef *ref)
+{
+    g_free (ref->name);
+    g_free (ref);
+}
+
+static void
+snap_weak_notify_cb (gpointer user_data, GObject *where_the_object_was G_GNUC_UNUSED)
+{
+    SnapRef *ref = user_data;
+    g_hash_table_remove (ref->self->snaps, ref->name);
+    store_metrics_add (STORE_METRIC_REGISTRY_SIZE, -1);
+}
+
+static SnapRef *
+find_snap_ref (StoreModel *self, StoreApp *app)
+{
+    SnapRef *ref = g_hash_table_lookup (self->snaps, store_app_get_name (app));
+    if (ref == NULL || STORE_APP (ref->snap) != app)
+        return NULL;
+    return ref;
+}
+
+static void
+touch_recent_snap (StoreModel *self, StoreSnapApp *snap)
+{
+    GList *link = g_queue_find (self->recent_snaps, snap);
+    if (link != NULL) {
+        g_queue_unlink (self->recent_snaps, link);
+        g_queue_push_head_link (self->recent_snaps, link);
+        return;
+    }
+
+    g_queue_push_head (self->recent_snaps, g_object_ref (snap));
+    while (g_queue_get_length (self->recent_snaps) > RECENT_SNAPS_LENGTH)
+        g_object_unref (g_queue_pop_tail (self->recent_snaps));
+}
+
+/* Search results are kept for the most recent searches, the oldest are dropped along with when they were validated */
+static void
+touch_recent_search (StoreModel *self, const gchar *query)
+{
+    GList *link = g_queue_find_custom (self->recent_searches, query, (GCompareFunc) g_strcmp0);
+    if (link != NULL) {
+        g_queue_unlink (self->recent_searches, link);
+        g_queue_push_head_link (self->recent_searches, link);
+        return;
+    }
+
+    g_queue_push_head (self->recent_searches, g_strdup (query));
+    while (g_queue_get_length (self->recent_searches) > RECENT_SEARCHES_LENGTH) {
+        g_autofree gchar *old_query = g_queue_pop_tail (self->recent_searches);
+        g_autofree gchar *id = g_strdup_printf ("%s/%s", data_kinds[DATA_KIND_SEARCH].name, old_query);
+        g_hash_table_remove (self->search_results, old_query);
+        g_hash_table_remove (self->validated, id);
+    }
+}
+
 typedef struct
 {
     StoreModel *self;
@@ -82,6 +268,7 @@ get_image_data_new (StoreModel *self, const gchar *uri, gint width, gint height)
     data->width = width;
     data->height = height;
     data->buffer = g_byte_array_new ();
+    store_metrics_add (STORE_METRIC_IMAGE_QUEUE_LENGTH, 1);
     return data;
 }
 
@@ -92,23 +279,183 @@ get_image_data_free (GetImageData *data)
     g_clear_pointer (&data->uri, g_free);
     g_clear_object (&data->message);
     g_clear_pointer (&data, g_free);
+    store_metrics_add (STORE_METRIC_IMAGE_QUEUE_LENGTH, -1);
+}
+
+typedef struct
+{
+    StoreApp *app;
+    gint64 start;
+} GetReviewsData;
+
+static GetReviewsData *
+get_reviews_data_new (StoreApp *app, gint64 start)
+{
+    GetReviewsData *data = g_new0 (GetReviewsData, 1);
+    data->app = g_object_ref (app);
+    data->start = start;
+    return data;
+}
+
+static void
+get_reviews_data_free (GetReviewsData *data)
+{
+    g_clear_object (&data->app);
+    g_free (data);
+}
+
+typedef struct
+{
+    gchar *query;
+    gint64 start_time;
+} SearchData;
+
+static SearchData *
+search_data_new (const gchar *query)
+{
+    SearchData *data = g_new0 (SearchData, 1);
+    data->query = g_strdup (query);
+    data->start_time = g_get_monotonic_time ();
+    return data;
+}
+
+static void
+search_data_free (SearchData *data)
+{
+    g_free (data->query);
+    g_free (data);
+}
+
+/* Snaps found in a category or search. They are only turned into apps a page at a time */
+typedef struct
+{
+    gboolean missing_tiles;
+    GPtrArray *names;
+    guint n_updated;
+    gboolean refreshing;
+    GPtrArray *snaps;
+} AppResults;
+
+static AppResults *
+app_results_new_from_names (GPtrArray *names)
+{
+    AppResults *results = g_new0 (AppResults, 1);
+    results->names = g_ptr_array_ref (names);
+    return results;
+}
+
+static AppResults *
+app_results_new_from_snaps (GPtrArray *snaps)
+{
+    AppResults *results = g_new0 (AppResults, 1);
+    results->snaps = g_ptr_array_ref (snaps);
+    return results;
+}
+
+static void
+app_results_free (AppResults *results)
+{
+    g_clear_pointer (&results->names, g_ptr_array_unref);
+    g_clear_pointer (&results->snaps, g_ptr_array_unref);
+    g_free (results);
+}
+
+static guint
+app_results_get_length (AppResults *results)
+{
+    return results->snaps != NULL ? results->snaps->len : results->names->len;
+}
+
+static gint64
+get_validated_time (StoreModel *self, DataKind kind, const gchar *key)
+{
+    g_autofree gchar *id = g_strdup_printf ("%s/%s", data_kinds[kind].name, key);
+    gint64 *time = g_hash_table_lookup (self->validated, id);
+    if (time != NULL)
+        return *time;
+
+    /* Otherwise use when it was last written to disk, possibly in a previous session.
+     * This is recorded when the startup cache is read, or only checked once if not */
+    if (self->cache == NULL || data_kinds[kind].cache_type == NULL)
+        return 0;
+    time = g_hash_table_lookup (self->cache_times, id);
+    if (time == NULL) {
+        time = g_new (gint64, 1);
+        *time = store_cache_get_modified_time (self->cache, data_kinds[kind].cache_type, key, FALSE);
+        g_hash_table_insert (self->cache_times, g_steal_pointer (&id), time);
+    }
+
+    return *time;
 }
 
+/* Unlike get_validated_time(), ignores anything checked in a previous session */
+static gboolean
+validated_this_session (StoreModel *self, DataKind kind, const gchar *key)
+{
+    g_autofree gchar *id = g_strdup_printf ("%s/%s", data_kinds[kind].name, key);
+    return g_hash_table_contains (self->validated, id);
+}
+
+static gboolean
+is_fresh (StoreModel *self, DataKind kind, const gchar *key)
+{
+    gint64 age = g_get_real_time () / G_USEC_PER_SEC - get_validated_time (self, kind, key);
+    return age >= 0 && age < data_kinds[kind].max_age;
+}
+
+static void
+set_validated (StoreModel *self, DataKind kind, const gchar *key)
+{
+    gint64 *time = g_new (gint64, 1);
+    *time = g_get_real_time () / G_USEC_PER_SEC;
+    g_hash_table_insert (self->validated, g_strdup_printf ("%s/%s", data_kinds[kind].name, key), time);
+}
+
+/* Makes the data be checked again next time, even if it is fresh on disk */
+static void
+invalidate (StoreModel *self, DataKind kind, const gchar *key)
+{
+    g_autofree gchar *id = g_strdup_printf ("%s/%s", data_kinds[kind].name, key);
+    g_hash_table_remove (self->validated, id);
+    if (data_kinds[kind].cache_type != NULL)
+        g_hash_table_insert (self->cache_times, g_steal_pointer (&id), g_new0 (gint64, 1));
+}
+
+/* Replaces @array with @new_array, only updating the items in @list that changed. Returns %TRUE if anything changed */
+static gboolean
+update_array (GPtrArray **array, GListStore *list, GPtrArray *new_array)
+{
+    g_clear_pointer (array, g_ptr_array_unref);
+    *array = g_ptr_array_ref (new_array);
+
+    /* Apps are shared through the registry, and categories are reused, so items can be compared by pointer */
+    return store_diff_update_list_store (list, new_array);
+}
+
+static void schedule_ratings_update (StoreModel *self);
+
 static void
 set_review_counts (StoreModel *self, StoreApp *app)
 {
     if (self->odrs_client == NULL)
         return;
 
-    gint64 *ratings = NULL;
-    if (store_app_get_appstream_id (app) != NULL)
-        ratings = store_odrs_client_get_ratings (self->odrs_client, store_app_get_appstream_id (app));
+    const gchar *appstream_id = store_app_get_appstream_id (app);
+    const guint32 *ratings = NULL;
+    if (appstream_id != NULL)
+        ratings = store_odrs_client_get_ratings (self->odrs_client, appstream_id);
+
+    /* Filtered ratings only cover the apps known when they were downloaded */
+    if (ratings == NULL && appstream_id != NULL && self->ratings_filtered && !g_hash_table_contains (self->rating_ids, appstream_id))
+        schedule_ratings_update (self);
 
+    g_object_freeze_notify (G_OBJECT (app));
     store_app_set_review_count_one_star (app, ratings != NULL ? ratings[0] : 0);
     store_app_set_review_count_two_star (app, ratings != NULL ? ratings[1] : 0);
     store_app_set_review_count_three_star (app, ratings != NULL ? ratings[2] : 0);
     store_app_set_review_count_four_star (app, ratings != NULL ? ratings[3] : 0);
     store_app_set_review_count_five_star (app, ratings != NULL ? ratings[4] : 0);
+    g_object_thaw_notify (G_OBJECT (app));
 }
 
 static GPtrArray *
@@ -131,6 +478,99 @@ load_cached_reviews (StoreModel *self, const gchar *name)
     return g_steal_pointer (&reviews);
 }
 
+/* The registry only holds weak references, so apps are re-hydrated from the cache if they have been freed */
+static StoreSnapApp *
+lookup_snap (StoreModel *self, const gchar *name, SnapRef **ref)
+{
+    g_autoptr(StoreSnapApp) snap = NULL;
+    SnapRef *r = g_hash_table_lookup (self->snaps, name);
+    if (r != NULL)
+        snap = g_object_ref (r->snap);
+    else {
+        snap = store_snap_app_new ();
+        store_snap_app_set_snapd_socket_path (snap, self->snapd_socket_path);
+        store_app_set_name (STORE_APP (snap), name);
+
+        r = g_new0 (SnapRef, 1);
+        r->self = self;
+        r->name = g_strdup (name);
+        r->snap = snap;
+        g_object_weak_ref (G_OBJECT (snap), snap_weak_notify_cb, r);
+        g_hash_table_insert (self->snaps, r->name, r);
+        store_metrics_add (STORE_METRIC_REGISTRY_SIZE, 1);
+    }
+    touch_recent_snap (self, snap);
+
+    *ref = r;
+    return g_steal_pointer (&snap);
+}
+
+/* Apps are read from the cache again once they have been in use for as long as snap data stays fresh */
+static gboolean
+snap_ref_is_fresh (SnapRef *ref)
+{
+    gint64 age = g_get_real_time () / G_USEC_PER_SEC - ref->hydrated_time;
+    return ref->hydrated && age >= 0 && age < data_kinds[DATA_KIND_SNAP].max_age;
+}
+
+static void
+hydrate_snap (StoreModel *self, SnapRef *ref, gboolean load_cache)
+{
+    if (load_cache && self->cache != NULL) {
+        store_app_update_from_cache (STORE_APP (ref->snap), self->cache);
+        ref->details_hydrated = FALSE;
+    }
+    set_review_counts (self, STORE_APP (ref->snap));
+
+    ref->hydrated = TRUE;
+    ref->hydrated_time = g_get_real_time () / G_USEC_PER_SEC;
+}
+
+/* Search results are newer than the cache, so there is no need to load it first */
+static StoreSnapApp *
+get_snap_from_search (StoreModel *self, SnapdSnap *snap)
+{
+    SnapRef *ref;
+    g_autoptr(StoreSnapApp) app = lookup_snap (self, snapd_snap_get_name (snap), &ref);
+    store_snap_app_update_from_search (app, snap);
+    if (!ref->hydrated)
+        hydrate_snap (self, ref, FALSE);
+    ref->hydrated_time = g_get_real_time () / G_USEC_PER_SEC;
+    ref->details_hydrated = TRUE;
+
+    if (self->cache != NULL)
+        store_app_save_to_cache (STORE_APP (app), self->cache);
+
+    return g_steal_pointer (&app);
+}
+
+/* Get the apps for results @start to @end. Search data is only applied (and cached) the first time each page is used */
+static GPtrArray *
+get_result_apps (StoreModel *self, AppResults *results, guint start, guint end)
+{
+    end = MIN (end, app_results_get_length (results));
+
+    g_autoptr(GPtrArray) apps = g_ptr_array_new_with_free_func (g_object_unref);
+    for (guint i = start; i < end; i++) {
+        if (results->snaps == NULL) {
+            g_autoptr(StoreSnapApp) app = store_model_get_snap (self, g_ptr_array_index (results->names, i));
+
+            /* Tiles are only cached for pages that have been shown, so the rest of the names need snapd */
+            if (store_app_get_title (STORE_APP (app)) == NULL)
+                results->missing_tiles = TRUE;
+            g_ptr_array_add (apps, g_steal_pointer (&app));
+        }
+        else if (i >= results->n_updated)
+            g_ptr_array_add (apps, get_snap_from_search (self, g_ptr_array_index (results->snaps, i)));
+        else
+            g_ptr_array_add (apps, store_model_get_snap (self, snapd_snap_get_name (g_ptr_array_index (results->snaps, i))));
+    }
+    if (results->snaps != NULL && start <= results->n_updated)
+        results->n_updated = MAX (results->n_updated, end);
+
+    return g_steal_pointer (&apps);
+}
+
 static const gchar *
 get_section_title (const gchar *name)
 {
@@ -211,57 +651,150 @@ get_section_summary (const gchar *name)
 }
 
 static GPtrArray *
-load_cached_category_apps (StoreModel *self, const gchar *section)
+json_to_names (JsonNode *node)
 {
-    g_autoptr(GPtrArray) apps = g_ptr_array_new_with_free_func (g_object_unref);
+    g_autoptr(GPtrArray) names = g_ptr_array_new_with_free_func (g_free);
+    if (!JSON_NODE_HOLDS_ARRAY (node))
+        return g_steal_pointer (&names);
+
+    JsonArray *array = json_node_get_array (node);
+    for (guint i = 0; i < json_array_get_length (array); i++) {
+        const gchar *name = json_array_get_string_element (array, i);
+        if (name != NULL)
+            g_ptr_array_add (names, g_strdup (name));
+    }
+
+    return g_steal_pointer (&names);
+}
+
+/* Only the first page of apps is loaded, the rest are loaded when scrolled to */
+static GPtrArray *
+set_category_app_names (StoreModel *self, const gchar *section, GPtrArray *names)
+{
+    AppResults *results = app_results_new_from_names (names);
+    g_hash_table_insert (self->category_results, g_strdup (section), results);
+
+    return get_result_apps (self, results, 0, APPS_PAGE_SIZE);
+}
 
+static GPtrArray *
+load_cached_category_apps (StoreModel *self, const gchar *section)
+{
     if (self->cache == NULL)
-        return g_steal_pointer (&apps);
+        return g_ptr_array_new_with_free_func (g_object_unref);
 
     g_autoptr(JsonNode) sections_cache = store_cache_lookup_json (self->cache, "sections", section, FALSE, NULL, NULL);
     if (sections_cache == NULL)
-        return g_steal_pointer (&apps);
+        return g_ptr_array_new_with_free_func (g_object_unref);
 
-    JsonArray *array = json_node_get_array (sections_cache);
-    for (guint j = 0; j < json_array_get_length (array); j++) {
-        JsonNode *node = json_array_get_element (array, j);
+    g_autoptr(GPtrArray) names = json_to_names (sections_cache);
+    return set_category_app_names (self, section, names);
+}
 
-        const gchar *name = json_node_get_string (node);
-        g_ptr_array_add (apps, store_model_get_snap (self, name));
-    }
+/* Cache entries needed at startup. These are read and parsed in a thread so the window can be shown first */
+typedef struct
+{
+    JsonNode *installed;
+    GHashTable *modified_times;
+    StoreRatings *ratings;
+    GHashTable *section_apps;
+    GPtrArray *sections;
+    GHashTable *snaps;
+} CachedData;
 
-    return g_steal_pointer (&apps);
+static CachedData *
+cached_data_new (void)
+{
+    CachedData *data = g_new0 (CachedData, 1);
+    data->modified_times = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    data->section_apps = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+    data->snaps = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) json_node_unref);
+    return data;
 }
 
-static GPtrArray *
-load_cached_categories (StoreModel *self)
+static void
+cached_data_free (CachedData *data)
 {
-    g_autoptr(GPtrArray) categories = g_ptr_array_new_with_free_func (g_object_unref);
+    g_clear_pointer (&data->installed, json_node_unref);
+    g_clear_pointer (&data->modified_times, g_hash_table_unref);
+    g_clear_object (&data->ratings);
+    g_clear_pointer (&data->section_apps, g_hash_table_unref);
+    g_clear_pointer (&data->sections, g_ptr_array_unref);
+    g_clear_pointer (&data->snaps, g_hash_table_unref);
+    g_free (data);
+}
 
-    if (self->cache == NULL)
-        return g_steal_pointer (&categories);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (CachedData, cached_data_free)
 
-    g_autoptr(JsonNode) sections_cache = store_cache_lookup_json (self->cache, "sections", "_index", FALSE, NULL, NULL);
-    if (sections_cache == NULL)
-        return g_steal_pointer (&categories);
+/* Record when a cache entry was written, so freshness checks don't need to look on disk */
+static void
+read_modified_time (StoreCache *cache, CachedData *data, DataKind kind, const gchar *key)
+{
+    gint64 *time = g_new (gint64, 1);
+    *time = store_cache_get_modified_time (cache, data_kinds[kind].cache_type, key, FALSE);
+    g_hash_table_insert (data->modified_times, g_strdup_printf ("%s/%s", data_kinds[kind].name, key), time);
+}
 
-    JsonArray *array = json_node_get_array (sections_cache);
-    g_autoptr(GPtrArray) section_array = g_ptr_array_new ();
-    for (guint i = 0; i < json_array_get_length (array); i++) {
-        JsonNode *node = json_array_get_element (array, i);
-        const gchar *section = json_node_get_string (node);
+static void
+read_cached_snap (StoreCache *cache, CachedData *data, const gchar *name)
+{
+    if (g_hash_table_contains (data->snaps, name))
+        return;
 
-        StoreCategory *category = store_category_new ();
-        g_ptr_array_add (categories, category);
-        store_category_set_name (category, section);
-        store_category_set_title (category, get_section_title (section));
-        store_category_set_summary (category, get_section_summary (section));
+    JsonNode *node = store_cache_lookup_json (cache, "snaps", name, FALSE, NULL, NULL);
+    if (node != NULL)
+        g_hash_table_insert (data->snaps, g_strdup (name), node);
+}
 
-        g_autoptr(GPtrArray) apps = load_cached_category_apps (self, section);
-        store_category_set_apps (category, apps);
+/* Runs in a worker thread, so only uses the cache and builds plain data */
+static void
+read_cache_thread (GTask *task, gpointer source_object G_GNUC_UNUSED, gpointer task_data, GCancellable *cancellable)
+{
+    StoreCache *cache = task_data;
+
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("model", "read-cache", NULL);
+
+    g_autoptr(CachedData) data = cached_data_new ();
+
+    g_autoptr(GBytes) ratings_data = store_cache_lookup_sync (cache, "ratings", "odrs", FALSE, NULL, NULL);
+    if (ratings_data != NULL) {
+        g_autoptr(GError) error = NULL;
+        data->ratings = store_ratings_new_from_bytes (ratings_data, &error);
+        if (data->ratings == NULL)
+            g_warning ("Failed to load cached ratings: %s", error->message);
     }
 
-    return g_steal_pointer (&categories);
+    g_autoptr(JsonNode) sections_cache = store_cache_lookup_json (cache, "sections", "_index", FALSE, NULL, NULL);
+    data->sections = sections_cache != NULL ? json_to_names (sections_cache) : g_ptr_array_new_with_free_func (g_free);
+    read_modified_time (cache, data, DATA_KIND_CATEGORIES, "_index");
+    for (guint i = 0; i < data->sections->len; i++) {
+        const gchar *section = g_ptr_array_index (data->sections, i);
+
+        if (g_cancellable_is_cancelled (cancellable))
+            break;
+
+        g_autoptr(JsonNode) section_cache = store_cache_lookup_json (cache, "sections", section, FALSE, NULL, NULL);
+        read_modified_time (cache, data, DATA_KIND_CATEGORY_APPS, section);
+        if (section_cache == NULL)
+            continue;
+
+        GPtrArray *names = json_to_names (section_cache);
+        g_hash_table_insert (data->section_apps, g_strdup (section), names);
+        for (guint j = 0; j < names->len && j < APPS_PAGE_SIZE; j++)
+            read_cached_snap (cache, data, g_ptr_array_index (names, j));
+    }
+
+    data->installed = store_cache_lookup_json (cache, "installed", "_index", FALSE, NULL, NULL);
+    if (data->installed != NULL && JSON_NODE_HOLDS_ARRAY (data->installed)) {
+        JsonArray *array = json_node_get_array (data->installed);
+        for (guint i = 0; i < json_array_get_length (array); i++) {
+            JsonObject *object = json_array_get_object_element (array, i);
+            if (object != NULL && json_object_has_member (object, "name"))
+                read_cached_snap (cache, data, json_object_get_string_member (object, "name"));
+        }
+    }
+
+    g_task_return_pointer (task, g_steal_pointer (&data), (GDestroyNotify) cached_data_free);
 }
 
 StoreCategory *
@@ -276,6 +809,324 @@ find_category (StoreModel *self, const gchar *section_name)
     return NULL;
 }
 
+static StoreCategory *
+get_category (StoreModel *self, const gchar *section)
+{
+    StoreCategory *category = find_category (self, section);
+    if (category != NULL)
+        return g_object_ref (category);
+
+    category = store_category_new ();
+    store_category_set_name (category, section);
+    store_category_set_title (category, get_section_title (section));
+    store_category_set_summary (category, get_section_summary (section));
+
+    return category;
+}
+
+/* Categories shown from the snapshot are reused, so only their apps change */
+static GPtrArray *
+get_cached_categories (StoreModel *self, CachedData *data)
+{
+    g_autoptr(GPtrArray) categories = g_ptr_array_new_with_free_func (g_object_unref);
+    for (guint i = 0; i < data->sections->len; i++) {
+        const gchar *section = g_ptr_array_index (data->sections, i);
+
+        StoreCategory *category = get_category (self, section);
+        g_ptr_array_add (categories, category);
+
+        GPtrArray *names = g_hash_table_lookup (data->section_apps, section);
+        if (names != NULL) {
+            g_autoptr(GPtrArray) apps = set_category_app_names (self, section, names);
+            store_category_set_apps (category, apps);
+        }
+    }
+
+    return g_steal_pointer (&categories);
+}
+
+/* Installed snaps from the last session, shown until snapd has been checked */
+static GPtrArray *
+get_cached_installed (StoreModel *self, CachedData *data)
+{
+    g_autoptr(GPtrArray) installed = g_ptr_array_new_with_free_func (g_object_unref);
+
+    JsonNode *installed_cache = data->installed;
+    if (installed_cache == NULL || !JSON_NODE_HOLDS_ARRAY (installed_cache))
+        return g_steal_pointer (&installed);
+
+    JsonArray *array = json_node_get_array (installed_cache);
+    for (guint i = 0; i < json_array_get_length (array); i++) {
+        JsonObject *object = json_array_get_object_element (array, i);
+        if (object == NULL || !json_object_has_member (object, "name"))
+            continue;
+
+        g_autoptr(StoreSnapApp) app = store_model_get_snap (self, json_object_get_string_member (object, "name"));
+        store_app_set_installed (STORE_APP (app), TRUE);
+        if (json_object_has_member (object, "installed-size"))
+            store_app_set_installed_size (STORE_APP (app), json_object_get_int_member (object, "installed-size"));
+        if (json_object_has_member (object, "updated-date")) {
+            g_autoptr(GDateTime) updated_date = g_date_time_new_from_unix_utc (json_object_get_int_member (object, "updated-date"));
+            store_app_set_updated_date (STORE_APP (app), updated_date);
+        }
+        g_ptr_array_add (installed, g_steal_pointer (&app));
+    }
+
+    return g_steal_pointer (&installed);
+}
+
+/* Everything needed to show the home page, in one cache entry so it can be shown before anything else is loaded */
+static void
+save_snapshot (StoreModel *self)
+{
+    if (self->snapshot_source != NULL)
+        g_source_destroy (self->snapshot_source);
+    g_clear_pointer (&self->snapshot_source, g_source_unref);
+
+    if (self->cache == NULL)
+        return;
+
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("model", "save-snapshot", NULL);
+
+    g_autoptr(GHashTable) apps = g_hash_table_new (g_direct_hash, g_direct_equal);
+    g_autoptr(JsonBuilder) builder = json_builder_new ();
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "categories");
+    json_builder_begin_array (builder);
+    for (guint i = 0; i < self->categories->len; i++) {
+        StoreCategory *category = g_ptr_array_index (self->categories, i);
+        GPtrArray *category_apps = store_category_get_apps (category);
+        json_builder_begin_object (builder);
+        json_builder_set_member_name (builder, "name");
+        json_builder_add_string_value (builder, store_category_get_name (category));
+        json_builder_set_member_name (builder, "apps");
+        json_builder_begin_array (builder);
+        for (guint j = 0; j < category_apps->len && j < HOME_SNAPSHOT_APPS; j++) {
+            StoreApp *app = g_ptr_array_index (category_apps, j);
+            json_builder_add_string_value (builder, store_app_get_name (app));
+            g_hash_table_add (apps, app);
+        }
+        json_builder_end_array (builder);
+        json_builder_end_object (builder);
+    }
+    json_builder_end_array (builder);
+    json_builder_set_member_name (builder, "banners");
+    json_builder_begin_array (builder);
+    for (int i = 0; banner_names[i] != NULL; i++) {
+        json_builder_add_string_value (builder, banner_names[i]);
+        SnapRef *ref = g_hash_table_lookup (self->snaps, banner_names[i]);
+        if (ref != NULL)
+            g_hash_table_add (apps, ref->snap);
+    }
+    json_builder_end_array (builder);
+    json_builder_set_member_name (builder, "snaps");
+    json_builder_begin_object (builder);
+    GHashTableIter iter;
+    g_hash_table_iter_init (&iter, apps);
+    gpointer key;
+    while (g_hash_table_iter_next (&iter, &key, NULL)) {
+        StoreApp *app = key;
+        JsonNode *node = store_snap_app_to_json (STORE_SNAP_APP (app));
+        const guint32 *ratings = NULL;
+        if (store_app_get_appstream_id (app) != NULL)
+            ratings = store_odrs_client_get_ratings (self->odrs_client, store_app_get_appstream_id (app));
+        if (ratings != NULL) {
+            JsonArray *ratings_array = json_array_sized_new (5);
+            for (int j = 0; j < 5; j++)
+                json_array_add_int_element (ratings_array, ratings[j]);
+            json_object_set_array_member (json_node_get_object (node), "ratings", ratings_array);
+        }
+        json_builder_set_member_name (builder, store_app_get_name (app));
+        json_builder_add_value (builder, node);
+    }
+    json_builder_end_object (builder);
+    json_builder_end_object (builder);
+
+    g_autoptr(JsonNode) root = json_builder_get_root (builder);
+    store_cache_insert_json (self->cache, "home", "_snapshot", FALSE, root, NULL, NULL);
+}
+
+static gboolean
+snapshot_timeout_cb (gpointer user_data)
+{
+    StoreModel *self = user_data;
+    save_snapshot (self);
+    return G_SOURCE_REMOVE;
+}
+
+/* Refreshes arrive in several parts, so save once they have all arrived */
+static void
+schedule_snapshot_save (StoreModel *self)
+{
+    if (self->snapshot_source != NULL)
+        g_source_destroy (self->snapshot_source);
+    g_clear_pointer (&self->snapshot_source, g_source_unref);
+    self->snapshot_source = g_timeout_source_new_seconds (SNAPSHOT_SAVE_DELAY);
+    g_source_set_callback (self->snapshot_source, snapshot_timeout_cb, self, NULL);
+    g_source_attach (self->snapshot_source, g_main_context_default ());
+}
+
+/* Show the home page from the last session before anything else is read */
+static void
+load_snapshot (StoreModel *self)
+{
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("model", "load-snapshot", NULL);
+
+    g_autoptr(JsonNode) snapshot = store_cache_lookup_json (self->cache, "home", "_snapshot", FALSE, NULL, NULL);
+    if (snapshot == NULL || !JSON_NODE_HOLDS_OBJECT (snapshot))
+        return;
+    JsonObject *object = json_node_get_object (snapshot);
+    if (!json_object_has_member (object, "categories") || !json_object_has_member (object, "snaps"))
+        return;
+
+    /* Keep the apps until they are in the categories */
+    g_autoptr(GPtrArray) snaps = g_ptr_array_new_with_free_func (g_object_unref);
+    JsonObject *snaps_object = json_object_get_object_member (object, "snaps");
+    g_autoptr(GList) names = json_object_get_members (snaps_object);
+    for (GList *link = names; link != NULL; link = link->next) {
+        const gchar *name = link->data;
+        JsonNode *node = json_object_get_member (snaps_object, name);
+
+        SnapRef *ref;
+        g_autoptr(StoreSnapApp) snap = lookup_snap (self, name, &ref);
+        if (!ref->hydrated) {
+            store_snap_app_update_from_json (snap, node);
+            JsonObject *snap_object = json_node_get_object (node);
+            if (json_object_has_member (snap_object, "ratings")) {
+                JsonArray *ratings = json_object_get_array_member (snap_object, "ratings");
+                if (json_array_get_length (ratings) == 5) {
+                    store_app_set_review_count_one_star (STORE_APP (snap), json_array_get_int_element (ratings, 0));
+                    store_app_set_review_count_two_star (STORE_APP (snap), json_array_get_int_element (ratings, 1));
+                    store_app_set_review_count_three_star (STORE_APP (snap), json_array_get_int_element (ratings, 2));
+                    store_app_set_review_count_four_star (STORE_APP (snap), json_array_get_int_element (ratings, 3));
+                    store_app_set_review_count_five_star (STORE_APP (snap), json_array_get_int_element (ratings, 4));
+                }
+            }
+            /* The snapshot may be older than the cache, so it is replaced when that is read */
+            ref->hydrated = TRUE;
+            ref->hydrated_time = 0;
+        }
+        g_ptr_array_add (snaps, g_steal_pointer (&snap));
+    }
+
+    g_autoptr(GPtrArray) categories = g_ptr_array_new_with_free_func (g_object_unref);
+    JsonArray *categories_array = json_object_get_array_member (object, "categories");
+    for (guint i = 0; i < json_array_get_length (categories_array); i++) {
+        JsonObject *category_object = json_array_get_object_element (categories_array, i);
+        StoreCategory *category = get_category (self, json_object_get_string_member (category_object, "name"));
+        g_ptr_array_add (categories, category);
+
+        g_autoptr(GPtrArray) apps = g_ptr_array_new_with_free_func (g_object_unref);
+        JsonArray *apps_array = json_object_get_array_member (category_object, "apps");
+        for (guint j = 0; j < json_array_get_length (apps_array); j++) {
+            SnapRef *ref = g_hash_table_lookup (self->snaps, json_array_get_string_element (apps_array, j));
+            if (ref != NULL)
+                g_ptr_array_add (apps, g_object_ref (ref->snap));
+        }
+        store_category_set_apps (category, apps);
+    }
+    if (update_array (&self->categories, self->category_list, categories))
+        g_object_notify (G_OBJECT (self), "categories");
+}
+
+/* Apply the data read from the cache in one go on the main thread */
+static void
+read_cache_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    StoreModel *self = STORE_MODEL (object);
+    g_autoptr(GTask) task = user_data;
+
+    g_autoptr(GError) error = NULL;
+    g_autoptr(CachedData) data = g_task_propagate_pointer (G_TASK (result), &error);
+    if (data == NULL) {
+        g_task_return_error (task, g_steal_pointer (&error));
+        return;
+    }
+
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("model", "apply-cache", NULL);
+
+    GHashTableIter times_iter;
+    g_hash_table_iter_init (&times_iter, data->modified_times);
+    gpointer id, time;
+    while (g_hash_table_iter_next (&times_iter, &id, &time)) {
+        g_hash_table_iter_steal (&times_iter);
+        g_hash_table_replace (self->cache_times, id, time);
+    }
+
+    /* Ratings downloaded in the meantime are newer. Update the snaps shown from the snapshot */
+    if (data->ratings != NULL && store_odrs_client_get_ratings_table (self->odrs_client) == NULL) {
+        store_odrs_client_set_ratings_table (self->odrs_client, data->ratings);
+
+        GHashTableIter iter;
+        g_hash_table_iter_init (&iter, self->snaps);
+        gpointer value;
+        while (g_hash_table_iter_next (&iter, NULL, &value)) {
+            SnapRef *ref = value;
+            set_review_counts (self, STORE_APP (ref->snap));
+        }
+    }
+
+    /* Hydrate the snaps that were read so they don't need to be read again.
+     * The registry only holds weak references, so keep them until they are in the lists below */
+    g_autoptr(GPtrArray) snaps = g_ptr_array_new_with_free_func (g_object_unref);
+    GHashTableIter iter;
+    g_hash_table_iter_init (&iter, data->snaps);
+    gpointer key, value;
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+        SnapRef *ref;
+        g_autoptr(StoreSnapApp) snap = lookup_snap (self, key, &ref);
+        if (!snap_ref_is_fresh (ref)) {
+            store_snap_app_update_from_json (snap, value);
+            hydrate_snap (self, ref, FALSE);
+        }
+        g_ptr_array_add (snaps, g_steal_pointer (&snap));
+    }
+
+    /* Skip anything snapd has already replaced */
+    if (!validated_this_session (self, DATA_KIND_CATEGORIES, "_index")) {
+        g_autoptr(GPtrArray) categories = get_cached_categories (self, data);
+        if (update_array (&self->categories, self->category_list, categories))
+            g_object_notify (G_OBJECT (self), "categories");
+        schedule_snapshot_save (self);
+    }
+
+    /* Checked against snapd when the installed snaps are next updated */
+    if (!validated_this_session (self, DATA_KIND_INSTALLED, "")) {
+        g_autoptr(GPtrArray) installed = get_cached_installed (self, data);
+        if (update_array (&self->installed, self->installed_list, installed))
+            g_object_notify (G_OBJECT (self), "installed");
+    }
+
+    g_task_return_boolean (task, TRUE);
+}
+
+static void
+save_installed (StoreModel *self)
+{
+    if (self->cache == NULL)
+        return;
+
+    /* The other fields are in each snap's own cache entry */
+    g_autoptr(JsonBuilder) builder = json_builder_new ();
+    json_builder_begin_array (builder);
+    for (guint i = 0; i < self->installed->len; i++) {
+        StoreApp *app = g_ptr_array_index (self->installed, i);
+        json_builder_begin_object (builder);
+        json_builder_set_member_name (builder, "name");
+        json_builder_add_string_value (builder, store_app_get_name (app));
+        json_builder_set_member_name (builder, "installed-size");
+        json_builder_add_int_value (builder, store_app_get_installed_size (app));
+        if (store_app_get_updated_date (app) != NULL) {
+            json_builder_set_member_name (builder, "updated-date");
+            json_builder_add_int_value (builder, g_date_time_to_unix (store_app_get_updated_date (app)));
+        }
+        json_builder_end_object (builder);
+    }
+    json_builder_end_array (builder);
+    g_autoptr(JsonNode) root = json_builder_get_root (builder);
+    store_cache_insert_json (self->cache, "installed", "_index", FALSE, root, NULL, NULL);
+}
+
 static void
 get_category_snaps_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 {
@@ -283,6 +1134,7 @@ get_category_snaps_cb (GObject *object, GAsyncResult *result, gpointer user_data
     StoreModel *self = data->self;
 
     g_autoptr(GError) error = NULL;
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     g_autoptr(GPtrArray) snaps = snapd_client_find_section_finish (SNAPD_CLIENT (object), result, NULL, &error);
     if (snaps == NULL) {
         if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
@@ -291,19 +1143,19 @@ get_category_snaps_cb (GObject *object, GAsyncResult *result, gpointer user_data
         return;
     }
 
-    g_autoptr(GPtrArray) apps = g_ptr_array_new_with_free_func (g_object_unref);
-    for (guint i = 0; i < snaps->len; i++) {
-        SnapdSnap *snap = g_ptr_array_index (snaps, i);
-        g_autoptr(StoreSnapApp) app = store_model_get_snap (self, snapd_snap_get_name (snap));
-        store_snap_app_update_from_search (app, snap);
-        if (self->cache != NULL)
-            store_app_save_to_cache (STORE_APP (app), self->cache);
-        g_ptr_array_add (apps, g_steal_pointer (&app));
-    }
+    AppResults *results = app_results_new_from_snaps (snaps);
+    g_hash_table_insert (self->category_results, g_strdup (data->section_name), results);
+
+    set_validated (self, DATA_KIND_CATEGORY_APPS, data->section_name);
 
+    /* Keep as many pages as have already been loaded */
     StoreCategory *category = find_category (self, data->section_name);
-    if (category != NULL)
+    if (category != NULL) {
+        guint n_apps = MAX (g_list_model_get_n_items (store_category_get_app_list (category)), APPS_PAGE_SIZE);
+        g_autoptr(GPtrArray) apps = get_result_apps (self, results, 0, n_apps);
         store_category_set_apps (category, apps);
+        schedule_snapshot_save (self);
+    }
 
     /* Save in cache */
     if (self->cache != NULL) {
@@ -319,51 +1171,250 @@ get_category_snaps_cb (GObject *object, GAsyncResult *result, gpointer user_data
     }
 }
 
+static void
+find_category_apps (StoreModel *self, const gchar *section_name, GCancellable *cancellable)
+{
+    g_autoptr(SnapdClient) client = snapd_client_new ();
+    snapd_client_set_socket_path (client, self->snapd_socket_path);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
+    snapd_client_find_section_async (client, SNAPD_FIND_FLAGS_SCOPE_WIDE, section_name, NULL, cancellable, get_category_snaps_cb, find_section_data_new (self, section_name));
+}
+
+/* Check the apps in categories that have not been checked recently */
+static void
+revalidate_category_apps (StoreModel *self, GCancellable *cancellable)
+{
+    for (guint i = 0; i < self->categories->len; i++) {
+        StoreCategory *category = g_ptr_array_index (self->categories, i);
+        const gchar *section_name = store_category_get_name (category);
+        if (!is_fresh (self, DATA_KIND_CATEGORY_APPS, section_name))
+            find_category_apps (self, section_name, cancellable);
+    }
+}
+
 static void
 get_sections_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 {
     g_autoptr(GTask) task = user_data;
 
     g_autoptr(GError) error = NULL;
+    store_trace_end_object (task);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     g_auto(GStrv) sections = snapd_client_get_sections_finish (SNAPD_CLIENT (object), result, &error);
     if (sections == NULL) {
         g_task_return_error (task, g_steal_pointer (&error));
         return;
-    }
+    }
+
+    StoreModel *self = g_task_get_source_object (task);
+
+    set_validated (self, DATA_KIND_CATEGORIES, "_index");
+
+    /* Reuse existing categories so only added and removed ones change.
+     * Ones shown from the snapshot only have their first few apps, so load the rest from the cache */
+    g_autoptr(GPtrArray) categories = g_ptr_array_new_with_free_func (g_object_unref);
+    for (int i = 0; sections[i] != NULL; i++) {
+        StoreCategory *category = get_category (self, sections[i]);
+        g_ptr_array_add (categories, category);
+        if (g_hash_table_contains (self->category_results, sections[i]))
+            continue;
+
+        g_autoptr(GPtrArray) apps = load_cached_category_apps (self, sections[i]);
+        if (apps->len > 0)
+            store_category_set_apps (category, apps);
+    }
+    gboolean changed = update_array (&self->categories, self->category_list, categories);
+
+    revalidate_category_apps (self, g_task_get_cancellable (task));
+
+    /* Save in cache */
+    if (self->cache != NULL) {
+        g_autoptr(JsonBuilder) builder = json_builder_new ();
+        json_builder_begin_array (builder);
+        for (int i = 0; sections[i] != NULL; i++)
+            json_builder_add_string_value (builder, sections[i]);
+        json_builder_end_array (builder);
+        g_autoptr(JsonNode) root = json_builder_get_root (builder);
+        store_cache_insert_json (self->cache, "sections", "_index", FALSE, root, NULL, NULL);
+    }
+
+    if (changed)
+        g_object_notify (G_OBJECT (self), "categories");
+    schedule_snapshot_save (self);
+
+    g_task_return_boolean (task, TRUE);
+}
+
+/* Adds or removes @app from the installed list, keeping it sorted by name like snapd returns it */
+static void
+update_installed_snap (StoreModel *self, StoreSnapApp *app, gboolean installed)
+{
+    const gchar *name = store_app_get_name (STORE_APP (app));
+
+    g_autoptr(GPtrArray) installed_apps = g_ptr_array_new_with_free_func (g_object_unref);
+    gboolean added = FALSE;
+    for (guint i = 0; i < self->installed->len; i++) {
+        StoreApp *a = g_ptr_array_index (self->installed, i);
+        if (g_strcmp0 (store_app_get_name (a), name) == 0)
+            continue;
+        if (installed && !added && g_strcmp0 (store_app_get_name (a), name) > 0) {
+            g_ptr_array_add (installed_apps, g_object_ref (app));
+            added = TRUE;
+        }
+        g_ptr_array_add (installed_apps, g_object_ref (a));
+    }
+    if (installed && !added)
+        g_ptr_array_add (installed_apps, g_object_ref (app));
+
+    store_app_set_installed (STORE_APP (app), installed);
+    if (update_array (&self->installed, self->installed_list, installed_apps)) {
+        g_object_notify (G_OBJECT (self), "installed");
+        save_installed (self);
+    }
+}
+
+static void
+get_changed_snap_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    g_autoptr(GetSnapData) data = user_data;
+    StoreModel *self = data->self;
+
+    g_autoptr(GError) error = NULL;
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
+    g_autoptr(SnapdSnap) snap = snapd_client_get_snap_finish (SNAPD_CLIENT (object), result, &error);
+    if (snap == NULL) {
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            return;
+        if (!g_error_matches (error, SNAPD_ERROR, SNAPD_ERROR_NOT_FOUND)) {
+            g_warning ("Failed to get changed snap %s: %s", data->name, error->message);
+            return;
+        }
+
+        /* Snap has been removed */
+        SnapRef *ref = g_hash_table_lookup (self->snaps, data->name);
+        if (ref != NULL)
+            update_installed_snap (self, ref->snap, FALSE);
+        return;
+    }
+
+    g_autoptr(StoreSnapApp) app = get_snap_from_search (self, snap);
+    update_installed_snap (self, app, TRUE);
+}
+
+/* snapd-glib doesn't report which snaps most changes affect, but snapd quotes them in the summary, e.g. 'Refresh snaps "foo", "bar"'.
+ * Other things are quoted too, e.g. 'Refresh "foo" snap from "edge" channel', so only names of snaps we know about are used */
+static GPtrArray *
+get_change_snap_names (StoreModel *self, SnapdChange *change)
+{
+    g_autoptr(GPtrArray) names = g_ptr_array_new_with_free_func (g_free);
+
+    const gchar *summary = snapd_change_get_summary (change);
+    const gchar *start;
+    while (summary != NULL && (start = strchr (summary, '"')) != NULL) {
+        const gchar *end = strchr (start + 1, '"');
+        if (end == NULL)
+            break;
+
+        gsize length = end - start - 1;
+        if (length > 0 && strspn (start + 1, "abcdefghijklmnopqrstuvwxyz0123456789-_") == length) {
+            g_autofree gchar *name = g_strndup (start + 1, length);
+            if (g_hash_table_contains (self->snaps, name))
+                g_ptr_array_add (names, g_steal_pointer (&name));
+        }
+        summary = end + 1;
+    }
+
+    return g_steal_pointer (&names);
+}
+
+static void poll_changes (StoreModel *self);
+
+static gboolean
+changes_timeout_cb (gpointer user_data)
+{
+    StoreModel *self = user_data;
+
+    g_clear_pointer (&self->changes_source, g_source_unref);
+    poll_changes (self);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+schedule_changes_poll (StoreModel *self)
+{
+    if (self->changes_source != NULL)
+        return;
 
-    StoreModel *self = g_task_get_source_object (task);
+    self->changes_source = g_timeout_source_new_seconds (CHANGES_POLL_INTERVAL);
+    g_source_set_callback (self->changes_source, changes_timeout_cb, self, NULL);
+    g_source_attach (self->changes_source, g_main_context_default ());
+}
 
-    g_clear_pointer (&self->categories, g_ptr_array_unref);
-    self->categories = g_ptr_array_new_with_free_func (g_object_unref);
-    for (int i = 0; sections[i] != NULL; i++) {
-        StoreCategory *category = store_category_new ();
-        g_ptr_array_add (self->categories, category);
-        store_category_set_name (category, sections[i]);
-        store_category_set_title (category, get_section_title (sections[i]));
-        store_category_set_summary (category, get_section_summary (sections[i]));
+static void
+get_changes_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    StoreModel *self = user_data;
 
-        g_autoptr(GPtrArray) apps = load_cached_category_apps (self, sections[i]);
-        store_category_set_apps (category, apps);
+    g_autoptr(GError) error = NULL;
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
+    g_autoptr(GPtrArray) changes = snapd_client_get_changes_finish (SNAPD_CLIENT (object), result, &error);
+    if (changes == NULL) {
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            return;
+        g_warning ("Failed to get snapd changes: %s", error->message);
 
-        g_autoptr(SnapdClient) client = snapd_client_new ();
-        snapd_client_set_socket_path (client, self->snapd_socket_path);
-        snapd_client_find_section_async (client, SNAPD_FIND_FLAGS_SCOPE_WIDE, sections[i], NULL, g_task_get_cancellable (task), get_category_snaps_cb, find_section_data_new (self, sections[i]));
+        /* Changes may have been missed, so get all the installed snaps next time */
+        self->changes_polling = FALSE;
+        g_clear_pointer (&self->ready_changes, g_hash_table_unref);
+        invalidate (self, DATA_KIND_INSTALLED, "");
+        return;
     }
 
-    /* Save in cache */
-    if (self->cache != NULL) {
-        g_autoptr(JsonBuilder) builder = json_builder_new ();
-        json_builder_begin_array (builder);
-        for (int i = 0; sections[i] != NULL; i++)
-            json_builder_add_string_value (builder, sections[i]);
-        json_builder_end_array (builder);
-        g_autoptr(JsonNode) root = json_builder_get_root (builder);
-        store_cache_insert_json (self->cache, "sections", "_index", FALSE, root, NULL, NULL);
+    /* Only look at the snaps in changes that have completed since the last check.
+     * Ones completed before the first check are already in the installed list */
+    g_autoptr(GHashTable) ready_changes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    for (guint i = 0; i < changes->len; i++) {
+        SnapdChange *change = g_ptr_array_index (changes, i);
+        if (!snapd_change_get_ready (change))
+            continue;
+
+        g_hash_table_add (ready_changes, g_strdup (snapd_change_get_id (change)));
+        if (self->ready_changes == NULL || g_hash_table_contains (self->ready_changes, snapd_change_get_id (change)))
+            continue;
+
+        g_autoptr(GPtrArray) names = get_change_snap_names (self, change);
+        for (guint j = 0; j < names->len; j++) {
+            const gchar *name = g_ptr_array_index (names, j);
+            g_autoptr(SnapdClient) client = snapd_client_new ();
+            snapd_client_set_socket_path (client, self->snapd_socket_path);
+            store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
+            snapd_client_get_snap_async (client, name, self->cancellable, get_changed_snap_cb, get_snap_data_new (self, name));
+        }
     }
+    g_clear_pointer (&self->ready_changes, g_hash_table_unref);
+    self->ready_changes = g_steal_pointer (&ready_changes);
+
+    self->changes_polling = FALSE;
+    schedule_changes_poll (self);
+}
+
+static void
+poll_changes (StoreModel *self)
+{
+    if (self->changes_polling)
+        return;
 
-    g_object_notify (G_OBJECT (self), "categories");
+    if (self->changes_source != NULL)
+        g_source_destroy (self->changes_source);
+    g_clear_pointer (&self->changes_source, g_source_unref);
 
-    g_task_return_boolean (task, TRUE);
+    self->changes_polling = TRUE;
+    g_autoptr(SnapdClient) client = snapd_client_new ();
+    snapd_client_set_socket_path (client, self->snapd_socket_path);
+    store_trace_mark ("snapd", "get-changes");
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
+    snapd_client_get_changes_async (client, SNAPD_CHANGE_FILTER_ALL, NULL, self->cancellable, get_changes_cb, self);
 }
 
 static void
@@ -372,6 +1423,8 @@ get_snaps_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     g_autoptr(GTask) task = user_data;
 
     g_autoptr(GError) error = NULL;
+    store_trace_end_object (task);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     g_autoptr(GPtrArray) snaps = snapd_client_get_snaps_finish (SNAPD_CLIENT (object), result, &error);
     if (snaps == NULL) {
         g_task_return_error (task, g_steal_pointer (&error));
@@ -380,19 +1433,34 @@ get_snaps_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 
     StoreModel *self = g_task_get_source_object (task);
 
-    g_clear_pointer (&self->installed, g_ptr_array_unref);
-    self->installed = g_ptr_array_new_with_free_func (g_object_unref);
+    set_validated (self, DATA_KIND_INSTALLED, "");
+
+    g_autoptr(GPtrArray) installed = g_ptr_array_new_with_free_func (g_object_unref);
     for (guint i = 0; i < snaps->len; i++) {
         SnapdSnap *snap = g_ptr_array_index (snaps, i);
-        g_autoptr(StoreSnapApp) app = store_model_get_snap (self, snapd_snap_get_name (snap));
+        g_autoptr(StoreSnapApp) app = get_snap_from_search (self, snap);
         store_app_set_installed (STORE_APP (app), TRUE);
-        store_snap_app_update_from_search (app, snap);
-        if (self->cache != NULL)
-            store_app_save_to_cache (STORE_APP (app), self->cache);
-        g_ptr_array_add (self->installed, g_steal_pointer (&app));
+        g_ptr_array_add (installed, g_steal_pointer (&app));
+    }
+
+    /* Snaps loaded from the cache may have been removed since */
+    g_autoptr(GHashTable) installed_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+    for (guint i = 0; i < installed->len; i++)
+        g_hash_table_add (installed_set, g_ptr_array_index (installed, i));
+    for (guint i = 0; i < self->installed->len; i++) {
+        StoreApp *app = g_ptr_array_index (self->installed, i);
+        if (!g_hash_table_contains (installed_set, app))
+            store_app_set_installed (app, FALSE);
+    }
+
+    if (update_array (&self->installed, self->installed_list, installed)) {
+        g_object_notify (G_OBJECT (self), "installed");
+        save_installed (self);
     }
 
-    g_object_notify (G_OBJECT (self), "installed");
+    /* Follow snapd changes from now on rather than getting all the snaps again */
+    if (self->ready_changes == NULL)
+        poll_changes (self);
 
     g_task_return_boolean (task, TRUE);
 }
@@ -410,18 +1478,23 @@ ratings_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 
     StoreModel *self = g_task_get_source_object (task);
 
+    self->ratings_filtered = self->filter_ratings;
+
     /* Update existing apps */
     GHashTableIter iter;
     g_hash_table_iter_init (&iter, self->snaps);
     gpointer key, value;
     while (g_hash_table_iter_next (&iter, &key, &value)) {
-        StoreSnapApp *snap = value;
-        gint64 *ratings = store_odrs_client_get_ratings (self->odrs_client, store_app_get_appstream_id (STORE_APP (snap)));
-        store_app_set_review_count_one_star (STORE_APP (snap), ratings != NULL ? ratings[0] : 0);
-        store_app_set_review_count_two_star (STORE_APP (snap), ratings != NULL ? ratings[1] : 0);
-        store_app_set_review_count_three_star (STORE_APP (snap), ratings != NULL ? ratings[2] : 0);
-        store_app_set_review_count_four_star (STORE_APP (snap), ratings != NULL ? ratings[3] : 0);
-        store_app_set_review_count_five_star (STORE_APP (snap), ratings != NULL ? ratings[4] : 0);
+        SnapRef *ref = value;
+        set_review_counts (self, STORE_APP (ref->snap));
+    }
+    schedule_snapshot_save (self);
+
+    /* Save in cache. Filtered ratings are missing the snaps not seen this session, so would be wrong to load next time */
+    StoreRatings *ratings = store_odrs_client_get_ratings_table (self->odrs_client);
+    if (self->cache != NULL && ratings != NULL && !self->filter_ratings) {
+        g_autoptr(GBytes) data = store_ratings_to_bytes (ratings);
+        store_cache_insert (self->cache, "ratings", "odrs", FALSE, data, NULL, NULL);
     }
 
     g_task_return_boolean (task, TRUE);
@@ -434,18 +1507,35 @@ reviews_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 
     g_autoptr(GError) error = NULL;
     g_autofree gchar *user_skey = NULL;
-    g_autoptr(GPtrArray) reviews = store_odrs_client_get_reviews_finish (STORE_ODRS_CLIENT (object), result, &user_skey, &error);
-    if (reviews == NULL) {
+    g_autoptr(GPtrArray) new_reviews = store_odrs_client_get_reviews_finish (STORE_ODRS_CLIENT (object), result, &user_skey, &error);
+    if (new_reviews == NULL) {
         g_task_return_error (task, g_steal_pointer (&error));
         return;
     }
     // FIXME: Store and use review key
 
     StoreModel *self = g_task_get_source_object (task);
-    StoreApp *app = g_task_get_task_data (task);
+    GetReviewsData *data = g_task_get_task_data (task);
+    StoreApp *app = data->app;
 
+    /* Add onto the existing reviews when loading more */
+    g_autoptr(GPtrArray) reviews = g_ptr_array_new_with_free_func (g_object_unref);
+    GPtrArray *existing_reviews = store_app_get_reviews (app);
+    for (guint i = 0; existing_reviews != NULL && i < existing_reviews->len && i < data->start; i++)
+        g_ptr_array_add (reviews, g_object_ref (g_ptr_array_index (existing_reviews, i)));
+    for (guint i = 0; i < new_reviews->len; i++)
+        g_ptr_array_add (reviews, g_object_ref (g_ptr_array_index (new_reviews, i)));
     store_app_set_reviews (app, reviews);
 
+    if (data->start == 0)
+        set_validated (self, DATA_KIND_REVIEWS, store_app_get_name (app));
+
+    SnapRef *ref = find_snap_ref (self, app);
+    if (ref != NULL) {
+        ref->reviews_fetched = TRUE;
+        ref->reviews_complete = new_reviews->len < REVIEWS_PAGE_SIZE;
+    }
+
     /* Save in cache */
     if (self->cache != NULL) {
         g_autoptr(JsonBuilder) builder = json_builder_new ();
@@ -462,6 +1552,48 @@ reviews_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     g_task_return_boolean (task, TRUE);
 }
 
+static void start_review_prefetches (StoreModel *self);
+
+static void
+review_prefetch_cb (GObject *object, GAsyncResult *result, gpointer user_data G_GNUC_UNUSED)
+{
+    StoreModel *self = STORE_MODEL (object);
+
+    g_autoptr(GError) error = NULL;
+    if (!g_task_propagate_boolean (G_TASK (result), &error)) {
+        if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_warning ("Failed to prefetch reviews: %s", error->message);
+
+        /* Allow to be tried again */
+        GetReviewsData *data = g_task_get_task_data (G_TASK (result));
+        SnapRef *ref = find_snap_ref (self, data->app);
+        if (ref != NULL)
+            ref->reviews_queued = FALSE;
+    }
+
+    self->n_review_prefetches--;
+    start_review_prefetches (self);
+}
+
+static void
+start_review_prefetches (StoreModel *self)
+{
+    while (self->n_review_prefetches < MAX_REVIEW_PREFETCHES && !g_queue_is_empty (self->review_prefetch_queue)) {
+        g_autoptr(StoreApp) app = g_queue_pop_head (self->review_prefetch_queue);
+
+        /* May have been fetched by the app page while queued */
+        SnapRef *ref = find_snap_ref (self, app);
+        if (ref != NULL && ref->reviews_fetched)
+            continue;
+
+        self->n_review_prefetches++;
+        g_autoptr(GTask) task = g_task_new (self, NULL, review_prefetch_cb, NULL);
+        g_task_set_task_data (task, get_reviews_data_new (app, 0), (GDestroyNotify) get_reviews_data_free);
+        store_odrs_client_get_reviews_async (self->odrs_client, store_app_get_appstream_id (app), NULL, NULL, 0, REVIEWS_PAGE_SIZE, G_PRIORITY_LOW,
+                                             NULL, reviews_cb, g_steal_pointer (&task));
+    }
+}
+
 static void
 image_size_cb (GetImageData *data, gint width, gint height, GdkPixbufLoader *loader)
 {
@@ -487,6 +1619,8 @@ image_size_cb (GetImageData *data, gint width, gint height, GdkPixbufLoader *loa
 static GdkPixbuf *
 process_image (GetImageData *image_data, GBytes *data, GError **error)
 {
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("image", "decode", image_data->uri);
+
     g_autoptr(GdkPixbufLoader) loader = gdk_pixbuf_loader_new ();
 
     g_signal_connect_swapped (loader, "size-prepared", G_CALLBACK (image_size_cb), image_data);
@@ -495,7 +1629,9 @@ process_image (GetImageData *image_data, GBytes *data, GError **error)
         !gdk_pixbuf_loader_close (loader, error))
         return NULL;
 
-    return g_object_ref (gdk_pixbuf_loader_get_pixbuf (loader));
+    GdkPixbuf *pixbuf = gdk_pixbuf_loader_get_pixbuf (loader);
+    store_metrics_add_image (G_OBJECT (pixbuf), gdk_pixbuf_get_byte_length (pixbuf));
+    return g_object_ref (pixbuf);
 }
 
 static void
@@ -615,6 +1751,8 @@ search_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     g_autoptr(GTask) task = user_data;
 
     g_autoptr(GError) error = NULL;
+    store_trace_end_object (task);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     g_autoptr(GPtrArray) snaps = snapd_client_find_finish (SNAPD_CLIENT (object), result, NULL, &error);
     if (snaps == NULL) {
         g_task_return_error (task, g_steal_pointer (&error));
@@ -622,18 +1760,18 @@ search_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     }
 
     StoreModel *self = g_task_get_source_object (task);
+    SearchData *data = g_task_get_task_data (task);
+    const gchar *query = data->query;
 
-    g_autoptr(GPtrArray) apps = g_ptr_array_new_with_free_func (g_object_unref);
-    for (guint i = 0; i < snaps->len; i++) {
-        SnapdSnap *snap = g_ptr_array_index (snaps, i);
-        g_autoptr(StoreSnapApp) app = store_model_get_snap (self, snapd_snap_get_name (snap));
-        store_snap_app_update_from_search (app, snap);
-        if (self->cache != NULL)
-            store_app_save_to_cache (STORE_APP (app), self->cache);
-        g_ptr_array_add (apps, g_steal_pointer (&app));
-    }
+    store_metrics_add_search_time (g_get_monotonic_time () - data->start_time);
+
+    /* Keep the results so the same search can be answered and paged through without asking snapd */
+    AppResults *results = app_results_new_from_snaps (snaps);
+    g_hash_table_insert (self->search_results, g_strdup (query), results);
+    set_validated (self, DATA_KIND_SEARCH, query);
+    touch_recent_search (self, query);
 
-    g_task_return_pointer (task, apps, (GDestroyNotify) g_ptr_array_unref);
+    g_task_return_pointer (task, get_result_apps (self, results, 0, APPS_PAGE_SIZE), (GDestroyNotify) g_ptr_array_unref);
 }
 
 static void
@@ -641,13 +1779,48 @@ store_model_dispose (GObject *object)
 {
     StoreModel *self = STORE_MODEL (object);
 
+    /* Save any pending snapshot so it is there next time */
+    if (self->snapshot_source != NULL)
+        save_snapshot (self);
     g_clear_object (&self->cache);
+    g_clear_pointer (&self->cache_times, g_hash_table_unref);
+    g_cancellable_cancel (self->cancellable);
+    g_clear_object (&self->cancellable);
     g_clear_pointer (&self->categories, g_ptr_array_unref);
+    g_clear_object (&self->category_list);
+    g_clear_pointer (&self->category_results, g_hash_table_unref);
+    if (self->changes_source != NULL)
+        g_source_destroy (self->changes_source);
+    g_clear_pointer (&self->changes_source, g_source_unref);
     g_clear_pointer (&self->installed, g_ptr_array_unref);
+    g_clear_object (&self->installed_list);
     g_clear_object (&self->odrs_client);
+    g_clear_pointer (&self->rating_ids, g_hash_table_unref);
+    if (self->ratings_source != NULL)
+        g_source_destroy (self->ratings_source);
+    g_clear_pointer (&self->ratings_source, g_source_unref);
+    g_clear_pointer (&self->ready_changes, g_hash_table_unref);
+    if (self->recent_searches != NULL)
+        g_queue_free_full (g_steal_pointer (&self->recent_searches), g_free);
+    if (self->recent_snaps != NULL)
+        g_queue_free_full (g_steal_pointer (&self->recent_snaps), g_object_unref);
+    if (self->review_prefetch_queue != NULL)
+        g_queue_free_full (g_steal_pointer (&self->review_prefetch_queue), g_object_unref);
+    g_clear_pointer (&self->search_results, g_hash_table_unref);
     g_clear_object (&self->session);
     g_clear_pointer (&self->snapd_socket_path, g_free);
+    if (self->snaps != NULL) {
+        GHashTableIter iter;
+        g_hash_table_iter_init (&iter, self->snaps);
+        gpointer key, value;
+        while (g_hash_table_iter_next (&iter, &key, &value)) {
+            SnapRef *ref = value;
+            g_object_weak_unref (G_OBJECT (ref->snap), snap_weak_notify_cb, ref);
+        }
+        store_metrics_add (STORE_METRIC_REGISTRY_SIZE, -(gint64) g_hash_table_size (self->snaps));
+    }
     g_clear_pointer (&self->snaps, g_hash_table_unref);
+    g_clear_pointer (&self->validated, g_hash_table_unref);
 
     G_OBJECT_CLASS (store_model_parent_class)->dispose (object);
 }
@@ -696,11 +1869,24 @@ static void
 store_model_init (StoreModel *self)
 {
     self->cache = store_cache_new ();
+    self->cache_times = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    self->cancellable = g_cancellable_new ();
     self->categories = g_ptr_array_new ();
+    self->category_list = g_list_store_new (store_category_get_type ());
+    self->category_results = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) app_results_free);
     self->installed = g_ptr_array_new ();
+    self->installed_list = g_list_store_new (store_app_get_type ());
     self->odrs_client = store_odrs_client_new ();
+    self->rating_ids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    self->ratings_max_age = DEFAULT_RATINGS_MAX_AGE;
+    self->recent_searches = g_queue_new ();
+    self->recent_snaps = g_queue_new ();
+    self->review_prefetch_queue = g_queue_new ();
+    self->search_results = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) app_results_free);
     self->session = soup_session_new ();
-    self->snaps = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+    store_metrics_watch_soup_session (self->session);
+    self->snaps = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) snap_ref_free);
+    self->validated = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 }
 
 StoreModel *
@@ -715,6 +1901,7 @@ store_model_set_cache (StoreModel *self, StoreCache *cache)
     g_return_if_fail (STORE_IS_MODEL (self));
 
     g_set_object (&self->cache, cache);
+    g_hash_table_remove_all (self->cache_times);
 }
 
 StoreCache *
@@ -741,6 +1928,22 @@ store_model_get_odrs_server (StoreModel *self)
     return store_odrs_client_get_server_uri (self->odrs_client);
 }
 
+void
+store_model_set_filter_ratings (StoreModel *self, gboolean filter_ratings)
+{
+    g_return_if_fail (STORE_IS_MODEL (self));
+
+    self->filter_ratings = filter_ratings;
+}
+
+void
+store_model_set_ratings_max_age (StoreModel *self, gint64 max_age)
+{
+    g_return_if_fail (STORE_IS_MODEL (self));
+
+    self->ratings_max_age = max_age;
+}
+
 void
 store_model_set_snapd_socket_path (StoreModel *self, const gchar *path)
 {
@@ -751,12 +1954,32 @@ store_model_set_snapd_socket_path (StoreModel *self, const gchar *path)
 }
 
 void
-store_model_load (StoreModel *self)
+store_model_load_async (StoreModel *self,
+                        GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
 {
     g_return_if_fail (STORE_IS_MODEL (self));
 
-    self->categories = load_cached_categories (self);
-    g_object_notify (G_OBJECT (self), "categories");
+    g_autoptr(GTask) task = g_task_new (self, cancellable, callback, callback_data);
+
+    if (self->cache == NULL) {
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    load_snapshot (self);
+
+    g_autoptr(GTask) read_task = g_task_new (self, cancellable, read_cache_cb, g_steal_pointer (&task));
+    g_task_set_task_data (read_task, g_object_ref (self->cache), g_object_unref);
+    g_task_run_in_thread (read_task, read_cache_thread);
+}
+
+gboolean
+store_model_load_finish (StoreModel *self, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), FALSE);
+    g_return_val_if_fail (g_task_is_valid (G_TASK (result), self), FALSE);
+
+    return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 StoreSnapApp *
@@ -764,22 +1987,62 @@ store_model_get_snap (StoreModel *self, const gchar *name)
 {
     g_return_val_if_fail (STORE_IS_MODEL (self), NULL);
 
-    StoreSnapApp *snap = g_hash_table_lookup (self->snaps, name);
-    if (snap == NULL) {
-        snap = store_snap_app_new ();
-        store_snap_app_set_snapd_socket_path (snap, self->snapd_socket_path);
-        store_app_set_name (STORE_APP (snap), name);
-        g_hash_table_insert (self->snaps, g_strdup (name), snap); // FIXME: Use a weak ref to clean out when no-longer used
-    }
+    SnapRef *ref;
+    g_autoptr(StoreSnapApp) snap = lookup_snap (self, name, &ref);
+    if (!snap_ref_is_fresh (ref))
+        hydrate_snap (self, ref, TRUE);
 
-    if (self->cache != NULL)
-        store_app_update_from_cache (STORE_APP (snap), self->cache);
-    set_review_counts (self, STORE_APP (snap));
-    g_autoptr(GPtrArray) reviews = load_cached_reviews (self, name);
-    if (reviews != NULL)
-        store_app_set_reviews (STORE_APP (snap), reviews);
+    return g_steal_pointer (&snap);
+}
+
+/* Reads @name from the cache again, including the details loaded by store_model_load_details() */
+StoreSnapApp *
+store_model_reload_snap (StoreModel *self, const gchar *name)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), NULL);
+
+    SnapRef *ref;
+    g_autoptr(StoreSnapApp) snap = lookup_snap (self, name, &ref);
+    ref->hydrated = FALSE;
+    ref->details_hydrated = FALSE;
+    hydrate_snap (self, ref, TRUE);
+
+    return g_steal_pointer (&snap);
+}
 
-    return g_object_ref (snap);
+GPtrArray *
+store_model_get_banner_apps (StoreModel *self)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), NULL);
+
+    GPtrArray *apps = g_ptr_array_new_with_free_func (g_object_unref);
+    for (int i = 0; banner_names[i] != NULL; i++)
+        g_ptr_array_add (apps, store_model_get_snap (self, banner_names[i]));
+
+    return apps;
+}
+
+void
+store_model_load_details (StoreModel *self, StoreApp *app)
+{
+    g_return_if_fail (STORE_IS_MODEL (self));
+    g_return_if_fail (STORE_IS_APP (app));
+
+    /* Only summary fields are loaded for tiles, the rest is loaded when the app is shown */
+    SnapRef *ref = g_hash_table_lookup (self->snaps, store_app_get_name (app));
+    if (ref == NULL || !ref->details_hydrated) {
+        if (self->cache != NULL)
+            store_app_update_details_from_cache (app, self->cache);
+        if (ref != NULL)
+            ref->details_hydrated = TRUE;
+    }
+
+    GPtrArray *current_reviews = store_app_get_reviews (app);
+    if (current_reviews == NULL || current_reviews->len == 0) {
+        g_autoptr(GPtrArray) reviews = load_cached_reviews (self, store_app_get_name (app));
+        if (reviews != NULL)
+            store_app_set_reviews (app, reviews);
+    }
 }
 
 GPtrArray *
@@ -789,6 +2052,13 @@ store_model_get_categories (StoreModel *self)
     return self->categories;
 }
 
+GListModel *
+store_model_get_category_list (StoreModel *self)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), NULL);
+    return G_LIST_MODEL (self->category_list);
+}
+
 void
 store_model_update_categories_async (StoreModel *self,
                                      GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
@@ -796,8 +2066,18 @@ store_model_update_categories_async (StoreModel *self,
     g_return_if_fail (STORE_IS_MODEL (self));
 
     g_autoptr(GTask) task = g_task_new (self, cancellable, callback, callback_data);
+
+    /* Keep using the loaded categories until they need to be checked again */
+    if (self->categories->len > 0 && is_fresh (self, DATA_KIND_CATEGORIES, "_index")) {
+        revalidate_category_apps (self, cancellable);
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
     g_autoptr(SnapdClient) client = snapd_client_new ();
     snapd_client_set_socket_path (client, self->snapd_socket_path);
+    store_trace_begin_object (task, "snapd", "get-sections", NULL);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
     snapd_client_get_sections_async (client, cancellable, get_sections_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
 }
 
@@ -810,6 +2090,46 @@ store_model_update_categories_finish (StoreModel *self, GAsyncResult *result, GE
     return g_task_propagate_boolean (G_TASK (result), error);
 }
 
+gboolean
+store_model_get_has_more_category_apps (StoreModel *self, StoreCategory *category)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), FALSE);
+    g_return_val_if_fail (STORE_IS_CATEGORY (category), FALSE);
+
+    AppResults *results = g_hash_table_lookup (self->category_results, store_category_get_name (category));
+    return results != NULL && g_list_model_get_n_items (store_category_get_app_list (category)) < app_results_get_length (results);
+}
+
+void
+store_model_load_more_category_apps (StoreModel *self, StoreCategory *category)
+{
+    g_return_if_fail (STORE_IS_MODEL (self));
+    g_return_if_fail (STORE_IS_CATEGORY (category));
+
+    AppResults *results = g_hash_table_lookup (self->category_results, store_category_get_name (category));
+    if (results == NULL)
+        return;
+
+    GListModel *app_list = store_category_get_app_list (category);
+    guint n_apps = g_list_model_get_n_items (app_list);
+    g_autoptr(GPtrArray) more_apps = get_result_apps (self, results, n_apps, n_apps + APPS_PAGE_SIZE);
+    if (more_apps->len == 0)
+        return;
+
+    /* Apps without cached tiles are filled in when snapd returns the category again */
+    if (results->missing_tiles && !results->refreshing) {
+        results->refreshing = TRUE;
+        find_category_apps (self, store_category_get_name (category), self->cancellable);
+    }
+
+    g_autoptr(GPtrArray) apps = g_ptr_array_new_with_free_func (g_object_unref);
+    for (guint i = 0; i < n_apps; i++)
+        g_ptr_array_add (apps, g_list_model_get_item (app_list, i));
+    for (guint i = 0; i < more_apps->len; i++)
+        g_ptr_array_add (apps, g_object_ref (g_ptr_array_index (more_apps, i)));
+    store_category_set_apps (category, apps);
+}
+
 GPtrArray *
 store_model_get_installed (StoreModel *self)
 {
@@ -817,6 +2137,13 @@ store_model_get_installed (StoreModel *self)
     return self->installed;
 }
 
+GListModel *
+store_model_get_installed_list (StoreModel *self)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), NULL);
+    return G_LIST_MODEL (self->installed_list);
+}
+
 void
 store_model_update_installed_async (StoreModel *self,
                                     GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
@@ -824,8 +2151,23 @@ store_model_update_installed_async (StoreModel *self,
     g_return_if_fail (STORE_IS_MODEL (self));
 
     g_autoptr(GTask) task = g_task_new (self, cancellable, callback, callback_data);
+
+    /* Once snapd changes are being followed the list is kept up to date, so just check for new ones */
+    if (self->ready_changes != NULL) {
+        poll_changes (self);
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    if (is_fresh (self, DATA_KIND_INSTALLED, "")) {
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
     g_autoptr(SnapdClient) client = snapd_client_new ();
     snapd_client_set_socket_path (client, self->snapd_socket_path);
+    store_trace_begin_object (task, "snapd", "get-snaps", NULL);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
     snapd_client_get_snaps_async (client, SNAPD_GET_SNAPS_FLAGS_NONE, NULL, cancellable, get_snaps_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
 }
 
@@ -838,6 +2180,53 @@ store_model_update_installed_finish (StoreModel *self, GAsyncResult *result, GEr
     return g_task_propagate_boolean (G_TASK (result), error);
 }
 
+static void
+download_ratings (StoreModel *self, GTask *task)
+{
+    /* Only keep ratings for the snaps we know about. Snaps seen before are kept even if they are no longer in use */
+    if (self->filter_ratings) {
+        GHashTableIter iter;
+        g_hash_table_iter_init (&iter, self->snaps);
+        gpointer key, value;
+        while (g_hash_table_iter_next (&iter, &key, &value)) {
+            SnapRef *ref = value;
+            const gchar *appstream_id = store_app_get_appstream_id (STORE_APP (ref->snap));
+            if (appstream_id != NULL)
+                g_hash_table_add (self->rating_ids, g_strdup (appstream_id));
+        }
+        g_autofree gchar **app_ids = (gchar **) g_hash_table_get_keys_as_array (self->rating_ids, NULL);
+        store_odrs_client_set_ratings_filter (self->odrs_client, app_ids);
+    }
+    else
+        store_odrs_client_set_ratings_filter (self->odrs_client, NULL);
+
+    store_odrs_client_update_ratings_async (self->odrs_client, g_task_get_cancellable (task), ratings_cb, g_object_ref (task)); // FIXME: Combine cancellables
+}
+
+static gboolean
+ratings_timeout_cb (gpointer user_data)
+{
+    StoreModel *self = user_data;
+
+    g_clear_pointer (&self->ratings_source, g_source_unref);
+    g_autoptr(GTask) task = g_task_new (self, self->cancellable, NULL, NULL);
+    download_ratings (self, task);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* Download the ratings again to cover apps seen since they were filtered. Waits so apps shown together only cause one download */
+static void
+schedule_ratings_update (StoreModel *self)
+{
+    if (self->ratings_source != NULL)
+        return;
+
+    self->ratings_source = g_timeout_source_new_seconds (RATINGS_FILTER_DELAY);
+    g_source_set_callback (self->ratings_source, ratings_timeout_cb, self, NULL);
+    g_source_attach (self->ratings_source, g_main_context_default ());
+}
+
 void
 store_model_update_ratings_async (StoreModel *self,
                                   GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
@@ -845,7 +2234,18 @@ store_model_update_ratings_async (StoreModel *self,
     g_return_if_fail (STORE_IS_MODEL (self));
 
     g_autoptr(GTask) task = g_task_new (self, cancellable, callback, callback_data);
-    store_odrs_client_update_ratings_async (self->odrs_client, cancellable, ratings_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
+
+    /* Skip if checked recently */
+    StoreRatings *ratings = store_odrs_client_get_ratings_table (self->odrs_client);
+    if (ratings != NULL) {
+        gint64 age = g_get_real_time () / G_USEC_PER_SEC - store_ratings_get_fetch_time (ratings);
+        if (age >= 0 && age < self->ratings_max_age) {
+            g_task_return_boolean (task, TRUE);
+            return;
+        }
+    }
+
+    download_ratings (self, task);
 }
 
 gboolean
@@ -870,8 +2270,34 @@ store_model_update_reviews_async (StoreModel *self, StoreApp *app,
         return;
     }
 
-    g_task_set_task_data (task, g_object_ref (app), g_object_unref);
-    store_odrs_client_get_reviews_async (self->odrs_client, store_app_get_appstream_id (app), NULL, NULL, 40, cancellable, reviews_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
+    /* Already fetched in the background */
+    SnapRef *ref = find_snap_ref (self, app);
+    if (ref != NULL && ref->reviews_fetched) {
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    /* Use the cached reviews if they were checked recently */
+    if (is_fresh (self, DATA_KIND_REVIEWS, store_app_get_name (app))) {
+        GPtrArray *reviews = store_app_get_reviews (app);
+        if (reviews == NULL || reviews->len == 0) {
+            g_autoptr(GPtrArray) cached_reviews = load_cached_reviews (self, store_app_get_name (app));
+            if (cached_reviews != NULL)
+                store_app_set_reviews (app, cached_reviews);
+            reviews = store_app_get_reviews (app);
+        }
+        if (ref != NULL) {
+            ref->reviews_fetched = TRUE;
+            /* Only whole pages are loaded, so there may be more */
+            ref->reviews_complete = reviews == NULL || reviews->len == 0 || reviews->len % REVIEWS_PAGE_SIZE != 0;
+        }
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    g_task_set_task_data (task, get_reviews_data_new (app, 0), (GDestroyNotify) get_reviews_data_free);
+    store_odrs_client_get_reviews_async (self->odrs_client, store_app_get_appstream_id (app), NULL, NULL, 0, REVIEWS_PAGE_SIZE, G_PRIORITY_DEFAULT,
+                                         cancellable, reviews_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
 }
 
 gboolean
@@ -883,6 +2309,62 @@ store_model_update_reviews_finish (StoreModel *self, GAsyncResult *result, GErro
     return g_task_propagate_boolean (G_TASK (result), error);
 }
 
+void
+store_model_load_more_reviews_async (StoreModel *self, StoreApp *app,
+                                     GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
+{
+    g_return_if_fail (STORE_IS_MODEL (self));
+
+    g_autoptr(GTask) task = g_task_new (self, cancellable, callback, callback_data);
+
+    if (self->odrs_client == NULL) {
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    GPtrArray *reviews = store_app_get_reviews (app);
+    gint64 start = reviews != NULL ? reviews->len : 0;
+    g_task_set_task_data (task, get_reviews_data_new (app, start), (GDestroyNotify) get_reviews_data_free);
+    store_odrs_client_get_reviews_async (self->odrs_client, store_app_get_appstream_id (app), NULL, NULL, start, REVIEWS_PAGE_SIZE, G_PRIORITY_DEFAULT,
+                                         cancellable, reviews_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
+}
+
+gboolean
+store_model_load_more_reviews_finish (StoreModel *self, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), FALSE);
+    g_return_val_if_fail (g_task_is_valid (G_TASK (result), self), FALSE);
+
+    return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+gboolean
+store_model_get_has_more_reviews (StoreModel *self, StoreApp *app)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), FALSE);
+
+    SnapRef *ref = find_snap_ref (self, app);
+    return ref != NULL && ref->reviews_fetched && !ref->reviews_complete;
+}
+
+void
+store_model_prefetch_reviews (StoreModel *self, StoreApp *app)
+{
+    g_return_if_fail (STORE_IS_MODEL (self));
+    g_return_if_fail (STORE_IS_APP (app));
+
+    if (self->odrs_client == NULL || store_app_get_appstream_id (app) == NULL)
+        return;
+
+    SnapRef *ref = find_snap_ref (self, app);
+    if (ref == NULL || ref->reviews_fetched || ref->reviews_queued || is_fresh (self, DATA_KIND_REVIEWS, ref->name))
+        return;
+
+    ref->reviews_queued = TRUE;
+    g_queue_push_tail (self->review_prefetch_queue, g_object_ref (app));
+    start_review_prefetches (self);
+}
+
 void
 store_model_search_async (StoreModel *self, const gchar *query,
                           GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
@@ -890,8 +2372,20 @@ store_model_search_async (StoreModel *self, const gchar *query,
     g_return_if_fail (STORE_IS_MODEL (self));
 
     g_autoptr(GTask) task = g_task_new (self, cancellable, callback, callback_data);
+
+    /* Results are only kept for this session, so stale results are never shown */
+    AppResults *results = g_hash_table_lookup (self->search_results, query);
+    if (results != NULL && is_fresh (self, DATA_KIND_SEARCH, query)) {
+        touch_recent_search (self, query);
+        g_task_return_pointer (task, get_result_apps (self, results, 0, APPS_PAGE_SIZE), (GDestroyNotify) g_ptr_array_unref);
+        return;
+    }
+
+    g_task_set_task_data (task, search_data_new (query), (GDestroyNotify) search_data_free);
     g_autoptr(SnapdClient) client = snapd_client_new ();
     snapd_client_set_socket_path (client, self->snapd_socket_path);
+    store_trace_begin_object (task, "snapd", "find", query);
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
     snapd_client_find_async (client, SNAPD_FIND_FLAGS_SCOPE_WIDE, query, cancellable, search_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
 }
 
@@ -904,6 +2398,27 @@ store_model_search_finish (StoreModel *self, GAsyncResult *result, GError **erro
     return g_task_propagate_pointer (G_TASK (result), error);
 }
 
+gboolean
+store_model_get_has_more_search_results (StoreModel *self, const gchar *query, guint n_results)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), FALSE);
+
+    AppResults *results = g_hash_table_lookup (self->search_results, query);
+    return results != NULL && n_results < app_results_get_length (results);
+}
+
+GPtrArray *
+store_model_get_more_search_results (StoreModel *self, const gchar *query, guint n_results)
+{
+    g_return_val_if_fail (STORE_IS_MODEL (self), NULL);
+
+    AppResults *results = g_hash_table_lookup (self->search_results, query);
+    if (results == NULL)
+        return g_ptr_array_new_with_free_func (g_object_unref);
+
+    return get_result_apps (self, results, n_results, n_results + APPS_PAGE_SIZE);
+}
+
 gboolean
 store_model_get_cached_image_metadata_sync (StoreModel *self, const gchar *uri, gchar **etag, gint64 *width, gint64 *height, GCancellable *cancellable, GError **error)
 {
@@ -961,6 +2476,7 @@ store_model_get_image_async (StoreModel *self, const gchar *uri, const gchar *et
     image_data->message = soup_message_new ("GET", uri);
     if (etag != NULL)
         soup_message_headers_append (image_data->message->request_headers, "If-None-Match", etag);
+    store_trace_begin_object (task, "http", "get-image", uri);
     soup_session_send_async (self->session, image_data->message, cancellable, send_cb, g_steal_pointer (&task)); // FIXME: Combine cancellables
 }
 
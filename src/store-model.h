@@ -22,7 +22,10 @@ G_DECLARE_FINAL_TYPE   (StoreModel, store_model, STORE, MODEL, GObject)
 
 StoreModel    *store_model_new                            (void);
 
-void           store_model_load                           (StoreModel *model);
+void           store_model_load_async                     (StoreModel *model,
+                                                           GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
+
+gboolean       store_model_load_finish                    (StoreModel *model, GAsyncResult *result, GError **error);
 
 void           store_model_set_cache                      (StoreModel *model, StoreCache *cache);
 
@@ -32,19 +35,37 @@ void           store_model_set_odrs_server_uri            (StoreModel *model, co
 
 const gchar   *store_model_get_odrs_server_uri            (StoreModel *model);
 
+void           store_model_set_filter_ratings             (StoreModel *model, gboolean filter_ratings);
+
+void           store_model_set_ratings_max_age            (StoreModel *model, gint64 max_age);
+
 void           store_model_set_snapd_socket_path          (StoreModel *model, const gchar *path);
 
 StoreSnapApp  *store_model_get_snap                       (StoreModel *model, const gchar *name);
 
+StoreSnapApp  *store_model_reload_snap                    (StoreModel *model, const gchar *name);
+
+GPtrArray     *store_model_get_banner_apps                (StoreModel *model);
+
+void           store_model_load_details                   (StoreModel *model, StoreApp *app);
+
 GPtrArray     *store_model_get_categories                 (StoreModel *model);
 
+GListModel    *store_model_get_category_list              (StoreModel *model);
+
 void           store_model_update_categories_async        (StoreModel *model,
                                                            GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
 
 gboolean       store_model_update_categories_finish       (StoreModel *model, GAsyncResult *result, GError **error);
 
+gboolean       store_model_get_has_more_category_apps     (StoreModel *model, StoreCategory *category);
+
+void           store_model_load_more_category_apps        (StoreModel *model, StoreCategory *category);
+
 GPtrArray     *store_model_get_installed                  (StoreModel *model);
 
+GListModel    *store_model_get_installed_list             (StoreModel *model);
+
 void           store_model_update_installed_async         (StoreModel *model,
                                                            GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
 
@@ -60,11 +81,24 @@ void           store_model_update_reviews_async           (StoreModel *model, St
 
 gboolean       store_model_update_reviews_finish          (StoreModel *model, GAsyncResult *result, GError **error);
 
+void           store_model_load_more_reviews_async        (StoreModel *model, StoreApp *app,
+                                                           GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
+
+gboolean       store_model_load_more_reviews_finish       (StoreModel *model, GAsyncResult *result, GError **error);
+
+gboolean       store_model_get_has_more_reviews           (StoreModel *model, StoreApp *app);
+
+void           store_model_prefetch_reviews               (StoreModel *model, StoreApp *app);
+
 void           store_model_search_async                   (StoreModel *model, const gchar *query,
                                                            GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
 
 GPtrArray     *store_model_search_finish                  (StoreModel *model, GAsyncResult *result, GError **error);
 
+gboolean       store_model_get_has_more_search_results    (StoreModel *model, const gchar *query, guint n_results);
+
+GPtrArray     *store_model_get_more_search_results        (StoreModel *model, const gchar *query, guint n_results);
+
 gboolean       store_model_get_cached_image_metadata_sync (StoreModel *model, const gchar *uri, gchar **etag, gint64 *width, gint64 *height,
                                                            GCancellable *cancellable, GError **error);
 
@@ -9,10 +9,14 @@
 
 #include <json-glib/json-glib.h>
 #include <libsoup/soup.h>
+#include <string.h>
 
 #include "store-odrs-client.h"
 
+#include "store-metrics.h"
 #include "store-odrs-review.h"
+#include "store-ratings.h"
+#include "store-trace.h"
 
 struct _StoreOdrsClient
 {
@@ -21,7 +25,8 @@ struct _StoreOdrsClient
     GCancellable *cancellable;
     gchar *distro;
     gchar *locale;
-    GHashTable *ratings;
+    StoreRatings *ratings;
+    GHashTable *ratings_filter;
     gchar *server_uri;
     SoupSession *soup_session;
     gchar *user_hash;
@@ -43,6 +48,311 @@ get_user_hash (void)
     return g_compute_checksum_for_string (G_CHECKSUM_SHA1, salted, -1);
 }
 
+/* Maximum nesting of JSON containers in the ratings data */
+#define RATINGS_PARSER_MAX_DEPTH 32
+
+typedef enum
+{
+    LEX_STATE_NONE,
+    LEX_STATE_STRING,
+    LEX_STATE_ESCAPE,
+    LEX_STATE_UNICODE,
+    LEX_STATE_BARE
+} LexState;
+
+/* Incremental parser for the ratings dump, which is of the form:
+ * { "app-id": { "star0": 0, "star1": 1, ... "total": 15 }, ... } */
+typedef struct
+{
+    LexState lex_state;
+    GString *token;
+    guint unicode_length;
+    gunichar unicode_value;
+    gunichar high_surrogate;
+    gchar containers[RATINGS_PARSER_MAX_DEPTH];
+    guint depth;
+    gboolean expect_key;
+    GString *app_id;
+    GString *star_key;
+    guint32 counts[5];
+    GHashTable *filter;
+    StoreRatings *ratings;
+} RatingsParser;
+
+static RatingsParser *
+ratings_parser_new (GHashTable *filter)
+{
+    RatingsParser *parser = g_new0 (RatingsParser, 1);
+    parser->token = g_string_new (NULL);
+    parser->app_id = g_string_new (NULL);
+    parser->star_key = g_string_new (NULL);
+    if (filter != NULL)
+        parser->filter = g_hash_table_ref (filter);
+    parser->ratings = store_ratings_new ();
+    return parser;
+}
+
+static void
+ratings_parser_free (RatingsParser *parser)
+{
+    g_string_free (parser->token, TRUE);
+    g_string_free (parser->app_id, TRUE);
+    g_string_free (parser->star_key, TRUE);
+    g_clear_pointer (&parser->filter, g_hash_table_unref);
+    g_clear_object (&parser->ratings);
+    g_free (parser);
+}
+
+static gboolean
+ratings_parser_open (RatingsParser *parser, gchar type, GError **error)
+{
+    if (parser->depth == 0 && type != '{') {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to get ratings, server returned non JSON object");
+        return FALSE;
+    }
+    if (parser->depth >= RATINGS_PARSER_MAX_DEPTH) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Ratings data nested too deeply");
+        return FALSE;
+    }
+
+    /* Start of the ratings for an app */
+    if (parser->depth == 1 && type == '{')
+        memset (parser->counts, 0, sizeof (parser->counts));
+
+    parser->containers[parser->depth] = type;
+    parser->depth++;
+    parser->expect_key = type == '{';
+
+    return TRUE;
+}
+
+static gboolean
+ratings_parser_close (RatingsParser *parser, gchar type, GError **error)
+{
+    if (parser->depth == 0 || parser->containers[parser->depth - 1] != type) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Invalid JSON in ratings data");
+        return FALSE;
+    }
+
+    /* End of the ratings for an app */
+    if (parser->depth == 2 && type == '{') {
+        if (parser->filter == NULL || g_hash_table_contains (parser->filter, parser->app_id->str))
+            store_ratings_insert (parser->ratings, parser->app_id->str, parser->counts);
+    }
+
+    parser->depth--;
+    parser->expect_key = FALSE;
+
+    return TRUE;
+}
+
+static gboolean
+ratings_parser_string (RatingsParser *parser, GError **error)
+{
+    if (parser->depth == 0) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to get ratings, server returned non JSON object");
+        return FALSE;
+    }
+
+    if (parser->expect_key) {
+        if (parser->depth == 1)
+            g_string_assign (parser->app_id, parser->token->str);
+        else if (parser->depth == 2)
+            g_string_assign (parser->star_key, parser->token->str);
+        parser->expect_key = FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+ratings_parser_bare (RatingsParser *parser, GError **error)
+{
+    if (parser->depth == 0) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to get ratings, server returned non JSON object");
+        return FALSE;
+    }
+
+    /* Star counts are keyed "star1" to "star5", "star0" and "total" are ignored */
+    const gchar *key = parser->star_key->str;
+    if (parser->depth == 2 && parser->containers[1] == '{' &&
+        g_str_has_prefix (key, "star") && key[4] >= '1' && key[4] <= '5' && key[5] == '\0') {
+        const gchar *value = parser->token->str;
+        guint64 count = value[0] == '-' ? 0 : g_ascii_strtoull (value, NULL, 10);
+        parser->counts[key[4] - '1'] = MIN (count, G_MAXUINT32);
+    }
+
+    return TRUE;
+}
+
+static gboolean
+ratings_parser_structure (RatingsParser *parser, gchar c, GError **error)
+{
+    switch (c) {
+    case '{':
+    case '[':
+        return ratings_parser_open (parser, c, error);
+    case '}':
+        return ratings_parser_close (parser, '{', error);
+    case ']':
+        return ratings_parser_close (parser, '[', error);
+    case ',':
+        if (parser->depth > 0)
+            parser->expect_key = parser->containers[parser->depth - 1] == '{';
+        return TRUE;
+    case ':':
+        return TRUE;
+    default:
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Unexpected character '%c' in ratings data", c);
+        return FALSE;
+    }
+}
+
+static gboolean
+ratings_parser_unicode (RatingsParser *parser, gchar c, GError **error)
+{
+    gint value = g_ascii_xdigit_value (c);
+    if (value < 0) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Invalid unicode escape in ratings data");
+        return FALSE;
+    }
+    parser->unicode_value = parser->unicode_value << 4 | value;
+    parser->unicode_length++;
+    if (parser->unicode_length < 4)
+        return TRUE;
+
+    gunichar ch = parser->unicode_value;
+    if (ch >= 0xD800 && ch <= 0xDBFF)
+        parser->high_surrogate = ch;
+    else {
+        if (ch >= 0xDC00 && ch <= 0xDFFF && parser->high_surrogate != 0)
+            ch = 0x10000 + ((parser->high_surrogate - 0xD800) << 10) + (ch - 0xDC00);
+        parser->high_surrogate = 0;
+        g_string_append_unichar (parser->token, ch);
+    }
+    parser->lex_state = LEX_STATE_STRING;
+
+    return TRUE;
+}
+
+static gboolean
+ratings_parser_feed (RatingsParser *parser, const gchar *data, gsize data_length, GError **error)
+{
+    for (gsize i = 0; i < data_length; i++) {
+        gchar c = data[i];
+
+        switch (parser->lex_state) {
+        case LEX_STATE_STRING:
+            if (c == '"') {
+                parser->lex_state = LEX_STATE_NONE;
+                if (!ratings_parser_string (parser, error))
+                    return FALSE;
+            }
+            else if (c == '\\')
+                parser->lex_state = LEX_STATE_ESCAPE;
+            else
+                g_string_append_c (parser->token, c);
+            break;
+
+        case LEX_STATE_ESCAPE:
+            parser->lex_state = LEX_STATE_STRING;
+            switch (c) {
+            case 'b':
+                g_string_append_c (parser->token, '\b');
+                break;
+            case 'f':
+                g_string_append_c (parser->token, '\f');
+                break;
+            case 'n':
+                g_string_append_c (parser->token, '\n');
+                break;
+            case 'r':
+                g_string_append_c (parser->token, '\r');
+                break;
+            case 't':
+                g_string_append_c (parser->token, '\t');
+                break;
+            case 'u':
+                parser->lex_state = LEX_STATE_UNICODE;
+                parser->unicode_length = 0;
+                parser->unicode_value = 0;
+                break;
+            default:
+                g_string_append_c (parser->token, c);
+                break;
+            }
+            break;
+
+        case LEX_STATE_UNICODE:
+            if (!ratings_parser_unicode (parser, c, error))
+                return FALSE;
+            break;
+
+        case LEX_STATE_BARE:
+            if (g_ascii_isalnum (c) || c == '-' || c == '+' || c == '.') {
+                g_string_append_c (parser->token, c);
+                break;
+            }
+            parser->lex_state = LEX_STATE_NONE;
+            if (!ratings_parser_bare (parser, error))
+                return FALSE;
+            /* fall through - process the character that ended the value */
+
+        case LEX_STATE_NONE:
+            if (g_ascii_isspace (c))
+                break;
+            else if (c == '"') {
+                parser->lex_state = LEX_STATE_STRING;
+                g_string_truncate (parser->token, 0);
+            }
+            else if (g_ascii_isalnum (c) || c == '-') {
+                parser->lex_state = LEX_STATE_BARE;
+                g_string_truncate (parser->token, 0);
+                g_string_append_c (parser->token, c);
+            }
+            else if (!ratings_parser_structure (parser, c, error))
+                return FALSE;
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+static StoreRatings *
+ratings_parser_finish (RatingsParser *parser, GError **error)
+{
+    if (parser->lex_state != LEX_STATE_NONE || parser->depth != 0 || parser->containers[0] != '{') {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, "Incomplete ratings data");
+        return NULL;
+    }
+
+    return g_object_ref (parser->ratings);
+}
+
+typedef struct
+{
+    SoupMessage *message;
+    RatingsParser *parser;
+} GetRatingsData;
+
+static GetRatingsData *
+get_ratings_data_new (SoupMessage *message, GHashTable *filter)
+{
+    GetRatingsData *data = g_new0 (GetRatingsData, 1);
+    data->message = g_object_ref (message);
+    data->parser = ratings_parser_new (filter);
+    return data;
+}
+
+static void
+get_ratings_data_free (GetRatingsData *data)
+{
+    g_clear_object (&data->message);
+    g_clear_pointer (&data->parser, ratings_parser_free);
+    g_free (data);
+}
+
 static JsonNode *
 send_finish (GTask *task, GObject *object, GAsyncResult *result, GError **error)
 {
@@ -52,6 +362,7 @@ send_finish (GTask *task, GObject *object, GAsyncResult *result, GError **error)
 
     StoreOdrsClient *self = g_task_get_source_object (task);
 
+    g_autoptr(StoreTraceSpan) span = store_trace_begin ("json", "parse", "odrs");
     g_autoptr(JsonParser) parser = json_parser_new ();
     if (!json_parser_load_from_stream (parser, stream, self->cancellable, error))
         return NULL;
@@ -66,55 +377,75 @@ send_finish (GTask *task, GObject *object, GAsyncResult *result, GError **error)
 }
 
 static void
-get_ratings_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+ratings_read_cb (GObject *object, GAsyncResult *result, gpointer user_data)
 {
     g_autoptr(GTask) task = user_data;
 
     g_autoptr(GError) error = NULL;
-    g_autoptr(JsonNode) root = send_finish (task, object, result, &error);
-    if (root == NULL) {
+    g_autoptr(GBytes) data = g_input_stream_read_bytes_finish (G_INPUT_STREAM (object), result, &error);
+    if (data == NULL) {
         g_task_return_error (task, g_steal_pointer (&error));
         return;
     }
 
     StoreOdrsClient *self = g_task_get_source_object (task);
+    GetRatingsData *ratings_data = g_task_get_task_data (task);
+    RatingsParser *parser = ratings_data->parser;
+
+    /* Parse each block as it arrives, so the whole response is never held in memory */
+    gsize data_length;
+    const gchar *contents = g_bytes_get_data (data, &data_length);
+    if (data_length != 0) {
+        if (!ratings_parser_feed (parser, contents, data_length, &error)) {
+            g_task_return_error (task, g_steal_pointer (&error));
+            return;
+        }
+
+        g_input_stream_read_bytes_async (G_INPUT_STREAM (object), 65535, G_PRIORITY_DEFAULT, self->cancellable, ratings_read_cb, g_steal_pointer (&task));
+        return;
+    }
 
-    if (json_node_get_node_type (root) != JSON_NODE_OBJECT) {
-        g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to get ratings, server returned non JSON object");
+    g_autoptr(StoreRatings) ratings = ratings_parser_finish (parser, &error);
+    if (ratings == NULL) {
+        g_task_return_error (task, g_steal_pointer (&error));
         return;
     }
+    SoupMessageHeaders *headers = ratings_data->message->response_headers;
+    store_ratings_set_etag (ratings, soup_message_headers_get_one (headers, "ETag"));
+    store_ratings_set_last_modified (ratings, soup_message_headers_get_one (headers, "Last-Modified"));
+    store_ratings_set_fetch_time (ratings, g_get_real_time () / G_USEC_PER_SEC);
+    g_set_object (&self->ratings, ratings);
 
-    g_clear_pointer (&self->ratings, g_hash_table_unref);
-    self->ratings = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    g_task_return_boolean (task, TRUE);
+}
 
-    if (json_node_get_node_type (root) != JSON_NODE_OBJECT) {
-        g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_FAILED, "ODRS server returned non-object ratings");
+static void
+get_ratings_cb (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    g_autoptr(GTask) task = user_data;
+
+    g_autoptr(GError) error = NULL;
+    g_autoptr(GInputStream) stream = soup_session_send_finish (SOUP_SESSION (object), result, &error);
+    if (stream == NULL) {
+        g_task_return_error (task, g_steal_pointer (&error));
         return;
     }
-    JsonObject *ratings_object = json_node_get_object (root);
-    JsonObjectIter iter;
-    json_object_iter_init (&iter, ratings_object);
-    const gchar *app_id;
-    JsonNode *node;
-    while (json_object_iter_next (&iter, &app_id, &node)) {
-        if (json_node_get_node_type (node) != JSON_NODE_OBJECT)
-            continue;
-        JsonObject *o = json_node_get_object (node);
-        gint64 *values = g_new0 (gint64, 5);
-        if (json_object_has_member (o, "star1"))
-            values[0] = json_object_get_int_member (o, "star1");
-        if (json_object_has_member (o, "star2"))
-            values[1] = json_object_get_int_member (o, "star2");
-        if (json_object_has_member (o, "star3"))
-            values[2] = json_object_get_int_member (o, "star3");
-        if (json_object_has_member (o, "star4"))
-            values[3] = json_object_get_int_member (o, "star4");
-        if (json_object_has_member (o, "star5"))
-            values[4] = json_object_get_int_member (o, "star5");
-        g_hash_table_insert (self->ratings, g_strdup (app_id), values);
+
+    StoreOdrsClient *self = g_task_get_source_object (task);
+    GetRatingsData *data = g_task_get_task_data (task);
+
+    /* Existing ratings are still current */
+    if (data->message->status_code == SOUP_STATUS_NOT_MODIFIED && self->ratings != NULL) {
+        store_ratings_set_fetch_time (self->ratings, g_get_real_time () / G_USEC_PER_SEC);
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+    if (!SOUP_STATUS_IS_SUCCESSFUL (data->message->status_code)) {
+        g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_FAILED, "Failed to get ratings, server returned %u", data->message->status_code);
+        return;
     }
 
-    g_task_return_boolean (task, TRUE);
+    g_input_stream_read_bytes_async (stream, 65535, G_PRIORITY_DEFAULT, self->cancellable, ratings_read_cb, g_steal_pointer (&task));
 }
 
 static void
@@ -270,7 +601,8 @@ store_odrs_client_dispose (GObject *object)
     g_clear_object (&self->cancellable);
     g_clear_pointer (&self->distro, g_free);
     g_clear_pointer (&self->locale, g_free);
-    g_clear_pointer (&self->ratings, g_hash_table_unref);
+    g_clear_object (&self->ratings);
+    g_clear_pointer (&self->ratings_filter, g_hash_table_unref);
     g_clear_pointer (&self->server_uri, g_free);
     g_clear_object (&self->soup_session);
     g_clear_pointer (&self->user_hash, g_free);
@@ -292,6 +624,7 @@ store_odrs_client_init (StoreOdrsClient *self)
     self->locale = g_strdup ("en"); // FIXME
     self->server_uri = g_strdup ("https://odrs.gnome.org");
     self->soup_session = soup_session_new (); // FIXME: Support common session
+    store_metrics_watch_soup_session (self->soup_session);
     self->user_hash = get_user_hash ();
 }
 
@@ -334,7 +667,7 @@ store_odrs_client_set_locale (StoreOdrsClient *self, const gchar *locale)
     self->locale = g_strdup (locale);
 }
 
-gint64 *
+const guint32 *
 store_odrs_client_get_ratings (StoreOdrsClient *self, const gchar *app_id)
 {
     g_return_val_if_fail (STORE_IS_ODRS_CLIENT (self), NULL);
@@ -343,7 +676,37 @@ store_odrs_client_get_ratings (StoreOdrsClient *self, const gchar *app_id)
     if (self->ratings == NULL)
         return NULL;
 
-    return g_hash_table_lookup (self->ratings, app_id);
+    return store_ratings_lookup (self->ratings, app_id);
+}
+
+void
+store_odrs_client_set_ratings_table (StoreOdrsClient *self, StoreRatings *ratings)
+{
+    g_return_if_fail (STORE_IS_ODRS_CLIENT (self));
+
+    g_set_object (&self->ratings, ratings);
+}
+
+StoreRatings *
+store_odrs_client_get_ratings_table (StoreOdrsClient *self)
+{
+    g_return_val_if_fail (STORE_IS_ODRS_CLIENT (self), NULL);
+
+    return self->ratings;
+}
+
+void
+store_odrs_client_set_ratings_filter (StoreOdrsClient *self, GStrv app_ids)
+{
+    g_return_if_fail (STORE_IS_ODRS_CLIENT (self));
+
+    g_clear_pointer (&self->ratings_filter, g_hash_table_unref);
+    if (app_ids == NULL)
+        return;
+
+    self->ratings_filter = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    for (int i = 0; app_ids[i] != NULL; i++)
+        g_hash_table_add (self->ratings_filter, g_strdup (app_ids[i]));
 }
 
 void
@@ -355,7 +718,17 @@ store_odrs_client_update_ratings_async (StoreOdrsClient *self,
     g_autofree gchar *uri= g_strdup_printf ("%s/1.0/reviews/api/ratings", self->server_uri);
     g_autoptr(SoupMessage) message = soup_message_new ("GET", uri);
 
+    /* Only download if changed since the last time. Filtered ratings can't be reused as the filter may have changed */
+    if (self->ratings != NULL && self->ratings_filter == NULL) {
+        if (store_ratings_get_etag (self->ratings) != NULL)
+            soup_message_headers_append (message->request_headers, "If-None-Match", store_ratings_get_etag (self->ratings));
+        if (store_ratings_get_last_modified (self->ratings) != NULL)
+            soup_message_headers_append (message->request_headers, "If-Modified-Since", store_ratings_get_last_modified (self->ratings));
+    }
+
     GTask *task = g_task_new (self, cancellable, callback, callback_data); // FIXME: Need to combine cancellables?
+    g_task_set_task_data (task, get_ratings_data_new (message, self->ratings_filter), (GDestroyNotify) get_ratings_data_free);
+    store_trace_begin_object (task, "odrs", "update-ratings", NULL);
     soup_session_send_async (self->soup_session, message, self->cancellable, get_ratings_cb, task);
 }
 
@@ -369,7 +742,8 @@ store_odrs_client_update_ratings_finish (StoreOdrsClient *self, GAsyncResult *re
 }
 
 void
-store_odrs_client_get_reviews_async (StoreOdrsClient *self, const gchar *app_id, GStrv compat_ids, const gchar *version, gint64 limit, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
+store_odrs_client_get_reviews_async (StoreOdrsClient *self, const gchar *app_id, GStrv compat_ids, const gchar *version, gint64 start, gint64 limit, int io_priority,
+                                     GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data)
 {
     g_return_if_fail (STORE_IS_ODRS_CLIENT (self));
     g_return_if_fail (app_id != NULL);
@@ -399,6 +773,8 @@ store_odrs_client_get_reviews_async (StoreOdrsClient *self, const gchar *app_id,
     json_builder_add_string_value (builder, self->distro);
     json_builder_set_member_name (builder, "version");
     json_builder_add_string_value (builder, version);
+    json_builder_set_member_name (builder, "start");
+    json_builder_add_int_value (builder, start);
     json_builder_set_member_name (builder, "limit");
     json_builder_add_int_value (builder, limit);
     json_builder_end_object (builder);
@@ -409,7 +785,14 @@ store_odrs_client_get_reviews_async (StoreOdrsClient *self, const gchar *app_id,
     g_autofree gchar *json_text = json_generator_to_data (generator, &json_text_length);
     soup_message_set_request (message, "application/json; charset=utf-8", SOUP_MEMORY_COPY, json_text, json_text_length);
 
+    if (io_priority > G_PRIORITY_DEFAULT)
+        soup_message_set_priority (message, SOUP_MESSAGE_PRIORITY_LOW);
+    else if (io_priority < G_PRIORITY_DEFAULT)
+        soup_message_set_priority (message, SOUP_MESSAGE_PRIORITY_HIGH);
+
     GTask *task = g_task_new (self, cancellable, callback, callback_data); // FIXME: Need to combine cancellables?
+    g_task_set_priority (task, io_priority);
+    store_trace_begin_object (task, "odrs", "get-reviews", app_id);
     soup_session_send_async (self->soup_session, message, self->cancellable, get_reviews_cb, task);
 }
 
@@ -12,6 +12,7 @@
 #include <gio/gio.h>
 
 #include "store-odrs-review.h"
+#include "store-ratings.h"
 
 G_BEGIN_DECLS
 
@@ -27,14 +28,20 @@ void             store_odrs_client_set_distro           (StoreOdrsClient *client
 
 void             store_odrs_client_set_locale           (StoreOdrsClient *client, const gchar *locale);
 
-gint64          *store_odrs_client_get_ratings          (StoreOdrsClient *client, const gchar *app_id);
+const guint32   *store_odrs_client_get_ratings          (StoreOdrsClient *client, const gchar *app_id);
+
+void             store_odrs_client_set_ratings_table    (StoreOdrsClient *client, StoreRatings *ratings);
+
+StoreRatings    *store_odrs_client_get_ratings_table    (StoreOdrsClient *client);
+
+void             store_odrs_client_set_ratings_filter   (StoreOdrsClient *client, GStrv app_ids);
 
 void             store_odrs_client_update_ratings_async (StoreOdrsClient *client,
                                                          GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
 
 gboolean         store_odrs_client_update_ratings_finish (StoreOdrsClient *client, GAsyncResult *result, GError **error);
 
-void             store_odrs_client_get_reviews_async    (StoreOdrsClient *client, const gchar *app_id, GStrv compat_ids, const gchar *version, gint64 limit,
+void             store_odrs_client_get_reviews_async    (StoreOdrsClient *client, const gchar *app_id, GStrv compat_ids, const gchar *version, gint64 start, gint64 limit, int io_priority,
                                                          GCancellable *cancellable, GAsyncReadyCallback callback, gpointer callback_data);
 
 GPtrArray       *store_odrs_client_get_reviews_finish   (StoreOdrsClient *client, GAsyncResult *result, gchar **user_skey, GError **error);
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <gio/gio.h>
+#include <string.h>
+
+#include "store-ratings.h"
+
+/* Binary format: header, entries sorted by ID, the NUL separated IDs, then the ETag and Last-Modified values.
+ * All values little endian */
+#define RATINGS_MAGIC "SSRT"
+#define RATINGS_VERSION 2
+
+typedef struct
+{
+    gchar magic[4];
+    guint32 version;
+    guint32 n_entries;
+    guint32 strings_length;
+    gint64 fetch_time;
+    guint32 etag_length;
+    guint32 last_modified_length;
+} RatingsHeader;
+
+typedef struct
+{
+    guint32 id_offset;
+    guint32 counts[5];
+} RatingsEntry;
+
+struct _StoreRatings
+{
+    GObject parent_instance;
+
+    GArray *entries;
+    gchar *etag;
+    gint64 fetch_time;
+    gchar *last_modified;
+    gboolean sorted;
+    GString *strings;
+};
+
+G_DEFINE_TYPE (StoreRatings, store_ratings, G_TYPE_OBJECT)
+
+static gint
+compare_entry (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const RatingsEntry *entry_a = a;
+    const RatingsEntry *entry_b = b;
+    const gchar *strings = user_data;
+    return strcmp (strings + entry_a->id_offset, strings + entry_b->id_offset);
+}
+
+static void
+sort_entries (StoreRatings *self)
+{
+    if (self->sorted)
+        return;
+
+    /* Sort is stable, so when an ID is inserted more than once the last value is kept */
+    g_array_sort_with_data (self->entries, compare_entry, self->strings->str);
+    guint n_entries = 0;
+    for (guint i = 0; i < self->entries->len; i++) {
+        RatingsEntry *entry = &g_array_index (self->entries, RatingsEntry, i);
+        if (n_entries > 0 && compare_entry (&g_array_index (self->entries, RatingsEntry, n_entries - 1), entry, self->strings->str) == 0)
+            n_entries--;
+        g_array_index (self->entries, RatingsEntry, n_entries) = *entry;
+        n_entries++;
+    }
+    g_array_set_size (self->entries, n_entries);
+
+    self->sorted = TRUE;
+}
+
+static void
+store_ratings_dispose (GObject *object)
+{
+    StoreRatings *self = STORE_RATINGS (object);
+
+    g_clear_pointer (&self->entries, g_array_unref);
+    g_clear_pointer (&self->etag, g_free);
+    g_clear_pointer (&self->last_modified, g_free);
+    if (self->strings != NULL)
+        g_string_free (g_steal_pointer (&self->strings), TRUE);
+
+    G_OBJECT_CLASS (store_ratings_parent_class)->dispose (object);
+}
+
+static void
+store_ratings_class_init (StoreRatingsClass *klass)
+{
+    G_OBJECT_CLASS (klass)->dispose = store_ratings_dispose;
+}
+
+static void
+store_ratings_init (StoreRatings *self)
+{
+    self->entries = g_array_new (FALSE, FALSE, sizeof (RatingsEntry));
+    self->sorted = TRUE;
+    self->strings = g_string_new (NULL);
+}
+
+StoreRatings *
+store_ratings_new (void)
+{
+    return g_object_new (store_ratings_get_type (), NULL);
+}
+
+StoreRatings *
+store_ratings_new_from_bytes (GBytes *data, GError **error)
+{
+    gsize data_length;
+    const guint8 *contents = g_bytes_get_data (data, &data_length);
+
+    RatingsHeader header;
+    if (data_length < sizeof (header)) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Ratings data too short");
+        return NULL;
+    }
+    memcpy (&header, contents, sizeof (header));
+    if (memcmp (header.magic, RATINGS_MAGIC, 4) != 0) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Invalid ratings data");
+        return NULL;
+    }
+    if (GUINT32_FROM_LE (header.version) != RATINGS_VERSION) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Unsupported ratings version %u", GUINT32_FROM_LE (header.version));
+        return NULL;
+    }
+    guint32 n_entries = GUINT32_FROM_LE (header.n_entries);
+    guint32 strings_length = GUINT32_FROM_LE (header.strings_length);
+    guint32 etag_length = GUINT32_FROM_LE (header.etag_length);
+    guint32 last_modified_length = GUINT32_FROM_LE (header.last_modified_length);
+    if ((data_length - sizeof (header)) / sizeof (RatingsEntry) < n_entries ||
+        data_length != sizeof (header) + (gsize) n_entries * sizeof (RatingsEntry) + strings_length + etag_length + last_modified_length ||
+        (strings_length > 0 && contents[data_length - etag_length - last_modified_length - 1] != '\0')) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Invalid ratings data length");
+        return NULL;
+    }
+
+    g_autoptr(StoreRatings) self = store_ratings_new ();
+    const guint8 *strings = contents + sizeof (header) + (gsize) n_entries * sizeof (RatingsEntry);
+    g_string_append_len (self->strings, (const gchar *) strings, strings_length);
+    if (etag_length > 0)
+        self->etag = g_strndup ((const gchar *) strings + strings_length, etag_length);
+    if (last_modified_length > 0)
+        self->last_modified = g_strndup ((const gchar *) strings + strings_length + etag_length, last_modified_length);
+    self->fetch_time = GINT64_FROM_LE (header.fetch_time);
+    g_array_set_size (self->entries, n_entries);
+    memcpy (self->entries->data, contents + sizeof (header), (gsize) n_entries * sizeof (RatingsEntry));
+    for (guint i = 0; i < n_entries; i++) {
+        RatingsEntry *entry = &g_array_index (self->entries, RatingsEntry, i);
+        entry->id_offset = GUINT32_FROM_LE (entry->id_offset);
+        if (entry->id_offset >= strings_length) {
+            g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Invalid ratings ID offset");
+            return NULL;
+        }
+        for (int j = 0; j < 5; j++)
+            entry->counts[j] = GUINT32_FROM_LE (entry->counts[j]);
+    }
+
+    /* Data is written sorted, but don't trust it */
+    self->sorted = FALSE;
+    sort_entries (self);
+
+    return g_steal_pointer (&self);
+}
+
+GBytes *
+store_ratings_to_bytes (StoreRatings *self)
+{
+    g_return_val_if_fail (STORE_IS_RATINGS (self), NULL);
+
+    sort_entries (self);
+
+    RatingsHeader header;
+    memcpy (header.magic, RATINGS_MAGIC, 4);
+    header.version = GUINT32_TO_LE (RATINGS_VERSION);
+    header.n_entries = GUINT32_TO_LE (self->entries->len);
+    header.strings_length = GUINT32_TO_LE (self->strings->len);
+    header.fetch_time = GINT64_TO_LE (self->fetch_time);
+    guint32 etag_length = self->etag != NULL ? strlen (self->etag) : 0;
+    header.etag_length = GUINT32_TO_LE (etag_length);
+    guint32 last_modified_length = self->last_modified != NULL ? strlen (self->last_modified) : 0;
+    header.last_modified_length = GUINT32_TO_LE (last_modified_length);
+
+    g_autoptr(GByteArray) data = g_byte_array_sized_new (sizeof (header) + self->entries->len * sizeof (RatingsEntry) + self->strings->len + etag_length + last_modified_length);
+    g_byte_array_append (data, (const guint8 *) &header, sizeof (header));
+    for (guint i = 0; i < self->entries->len; i++) {
+        RatingsEntry *entry = &g_array_index (self->entries, RatingsEntry, i);
+        RatingsEntry e;
+        e.id_offset = GUINT32_TO_LE (entry->id_offset);
+        for (int j = 0; j < 5; j++)
+            e.counts[j] = GUINT32_TO_LE (entry->counts[j]);
+        g_byte_array_append (data, (const guint8 *) &e, sizeof (e));
+    }
+    g_byte_array_append (data, (const guint8 *) self->strings->str, self->strings->len);
+    if (self->etag != NULL)
+        g_byte_array_append (data, (const guint8 *) self->etag, etag_length);
+    if (self->last_modified != NULL)
+        g_byte_array_append (data, (const guint8 *) self->last_modified, last_modified_length);
+
+    return g_byte_array_free_to_bytes (g_steal_pointer (&data));
+}
+
+void
+store_ratings_insert (StoreRatings *self, const gchar *app_id, const guint32 *counts)
+{
+    g_return_if_fail (STORE_IS_RATINGS (self));
+    g_return_if_fail (app_id != NULL);
+
+    RatingsEntry entry;
+    entry.id_offset = self->strings->len;
+    memcpy (entry.counts, counts, sizeof (entry.counts));
+    g_string_append_len (self->strings, app_id, strlen (app_id) + 1);
+    g_array_append_val (self->entries, entry);
+    self->sorted = FALSE;
+}
+
+const guint32 *
+store_ratings_lookup (StoreRatings *self, const gchar *app_id)
+{
+    g_return_val_if_fail (STORE_IS_RATINGS (self), NULL);
+
+    if (app_id == NULL)
+        return NULL;
+
+    sort_entries (self);
+
+    guint start = 0, end = self->entries->len;
+    while (start < end) {
+        guint mid = start + (end - start) / 2;
+        RatingsEntry *entry = &g_array_index (self->entries, RatingsEntry, mid);
+        int cmp = strcmp (app_id, self->strings->str + entry->id_offset);
+        if (cmp == 0)
+            return entry->counts;
+        else if (cmp < 0)
+            end = mid;
+        else
+            start = mid + 1;
+    }
+
+    return NULL;
+}
+
+guint
+store_ratings_get_length (StoreRatings *self)
+{
+    g_return_val_if_fail (STORE_IS_RATINGS (self), 0);
+
+    sort_entries (self);
+
+    return self->entries->len;
+}
+
+void
+store_ratings_set_etag (StoreRatings *self, const gchar *etag)
+{
+    g_return_if_fail (STORE_IS_RATINGS (self));
+
+    g_free (self->etag);
+    self->etag = g_strdup (etag);
+}
+
+const gchar *
+store_ratings_get_etag (StoreRatings *self)
+{
+    g_return_val_if_fail (STORE_IS_RATINGS (self), NULL);
+
+    return self->etag;
+}
+
+void
+store_ratings_set_fetch_time (StoreRatings *self, gint64 fetch_time)
+{
+    g_return_if_fail (STORE_IS_RATINGS (self));
+
+    self->fetch_time = fetch_time;
+}
+
+gint64
+store_ratings_get_fetch_time (StoreRatings *self)
+{
+    g_return_val_if_fail (STORE_IS_RATINGS (self), 0);
+
+    return self->fetch_time;
+}
+
+void
+store_ratings_set_last_modified (StoreRatings *self, const gchar *last_modified)
+{
+    g_return_if_fail (STORE_IS_RATINGS (self));
+
+    g_free (self->last_modified);
+    self->last_modified = g_strdup (last_modified);
+}
+
+const gchar *
+store_ratings_get_last_modified (StoreRatings *self)
+{
+    g_return_val_if_fail (STORE_IS_RATINGS (self), NULL);
+
+    return self->last_modified;
+}
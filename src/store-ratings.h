@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE (StoreRatings, store_ratings, STORE, RATINGS, GObject)
+
+StoreRatings  *store_ratings_new               (void);
+
+StoreRatings  *store_ratings_new_from_bytes    (GBytes *data, GError **error);
+
+GBytes        *store_ratings_to_bytes          (StoreRatings *ratings);
+
+void           store_ratings_insert            (StoreRatings *ratings, const gchar *app_id, const guint32 *counts);
+
+const guint32 *store_ratings_lookup            (StoreRatings *ratings, const gchar *app_id);
+
+guint          store_ratings_get_length        (StoreRatings *ratings);
+
+void           store_ratings_set_etag          (StoreRatings *ratings, const gchar *etag);
+
+const gchar   *store_ratings_get_etag          (StoreRatings *ratings);
+
+void           store_ratings_set_fetch_time    (StoreRatings *ratings, gint64 fetch_time);
+
+gint64         store_ratings_get_fetch_time    (StoreRatings *ratings);
+
+void           store_ratings_set_last_modified (StoreRatings *ratings, const gchar *last_modified);
+
+const gchar   *store_ratings_get_last_modified (StoreRatings *ratings);
+
+G_END_DECLS
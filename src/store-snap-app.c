@@ -9,6 +9,8 @@
 
 #include "store-snap-app.h"
 
+#include "store-metrics.h"
+
 struct _StoreSnapApp
 {
     StoreApp parent_instance;
@@ -24,6 +26,7 @@ install_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     GTask *task = user_data;
 
     g_autoptr(GError) error = NULL;
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     if (!snapd_client_install2_finish (SNAPD_CLIENT (object), result, &error)) {
         if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
             return;
@@ -88,6 +91,7 @@ find_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     g_autoptr(GTask) task = user_data;
 
     g_autoptr(GError) error = NULL;
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     g_autoptr(GPtrArray) snaps = snapd_client_find_finish (SNAPD_CLIENT (object), result, NULL, &error);
     if (snaps == NULL) {
         if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
@@ -115,6 +119,7 @@ remove_cb (GObject *object, GAsyncResult *result, gpointer user_data)
     GTask *task = user_data;
 
     g_autoptr(GError) error = NULL;
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, -1);
     if (!snapd_client_remove_finish (SNAPD_CLIENT (object), result, &error)) {
         if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
             return;
@@ -143,6 +148,7 @@ store_snap_app_install_async (StoreApp *app, StoreChannel *channel G_GNUC_UNUSED
     g_autoptr(SnapdClient) client = snapd_client_new ();
     snapd_client_set_socket_path (client, self->snapd_socket_path);
     GTask *task = g_task_new (app, cancellable, callback, callback_data); // FIXME: Need to combine cancellables?
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
     snapd_client_install2_async (client, SNAPD_INSTALL_FLAGS_NONE, store_app_get_name (app), NULL, NULL, NULL, NULL, cancellable, install_cb, task); // FIXME: channel
 }
 
@@ -169,6 +175,7 @@ store_snap_app_refresh_async (StoreApp *app, GCancellable *cancellable, GAsyncRe
     g_autoptr(SnapdClient) client = snapd_client_new ();
     snapd_client_set_socket_path (client, self->snapd_socket_path);
     GTask *task = g_task_new (self, cancellable, callback, callback_data); // FIXME: Need to combine cancellables?
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
     snapd_client_find_async (client, SNAPD_FIND_FLAGS_MATCH_NAME, store_app_get_name (app), cancellable, find_cb, task);
 }
 
@@ -186,6 +193,7 @@ store_snap_app_remove_async (StoreApp *app, GCancellable *cancellable, GAsyncRea
     g_autoptr(SnapdClient) client = snapd_client_new ();
     snapd_client_set_socket_path (client, self->snapd_socket_path);
     GTask *task = g_task_new (self, cancellable, callback, callback_data); // FIXME: Need to combine cancellables?
+    store_metrics_add (STORE_METRIC_SNAPD_REQUESTS, 1);
     snapd_client_remove_async (client, store_app_get_name (app), NULL, NULL, cancellable, remove_cb, task);
 }
 
@@ -198,78 +206,55 @@ store_snap_app_remove_finish (StoreApp *self G_GNUC_UNUSED, GAsyncResult *result
 static void
 store_snap_app_save_to_cache (StoreApp *self, StoreCache *cache)
 {
-    g_autoptr(JsonBuilder) builder = json_builder_new ();
-    json_builder_begin_object (builder);
-    json_builder_set_member_name (builder, "appstream-id"); // FIXME: Move common fields into StoreApp
-    json_builder_add_string_value (builder, store_app_get_appstream_id (self));
-    if (store_app_get_banner (self) != NULL) {
-        json_builder_set_member_name (builder, "banner");
-        json_builder_add_value (builder, store_media_to_json (store_app_get_banner (self)));
-    }
+    /* Fields shown in tiles are kept separate from the larger fields only used on the app page */
+    g_autoptr(JsonNode) node = store_snap_app_to_json (STORE_SNAP_APP (self));
+    store_cache_insert_json (cache, "snaps", store_app_get_name (self), FALSE, node, NULL, NULL);
+
+    g_autoptr(JsonBuilder) details_builder = json_builder_new ();
+    json_builder_begin_object (details_builder);
     GPtrArray *channels = store_app_get_channels (self);
     if (channels->len > 0) {
-        json_builder_set_member_name (builder, "channels");
-        json_builder_begin_array (builder);
+        json_builder_set_member_name (details_builder, "channels");
+        json_builder_begin_array (details_builder);
         for (guint i = 0; i < channels->len; i++) {
             StoreChannel *channel = g_ptr_array_index (channels, i);
-            json_builder_add_value (builder, store_channel_to_json (channel));
+            json_builder_add_value (details_builder, store_channel_to_json (channel));
         }
-        json_builder_end_array (builder);
+        json_builder_end_array (details_builder);
     }
     if (store_app_get_contact (self) != NULL) {
-        json_builder_set_member_name (builder, "contact");
-        json_builder_add_string_value (builder, store_app_get_contact (self));
-    }
-    json_builder_set_member_name (builder, "description");
-    json_builder_add_string_value (builder, store_app_get_description (self));
-    if (store_app_get_icon (self) != NULL) {
-        json_builder_set_member_name (builder, "icon");
-        json_builder_add_value (builder, store_media_to_json (store_app_get_icon (self)));
+        json_builder_set_member_name (details_builder, "contact");
+        json_builder_add_string_value (details_builder, store_app_get_contact (self));
     }
+    json_builder_set_member_name (details_builder, "description");
+    json_builder_add_string_value (details_builder, store_app_get_description (self));
     if (store_app_get_license (self) != NULL) {
-        json_builder_set_member_name (builder, "license");
-        json_builder_add_string_value (builder, store_app_get_license (self));
+        json_builder_set_member_name (details_builder, "license");
+        json_builder_add_string_value (details_builder, store_app_get_license (self));
     }
-    json_builder_set_member_name (builder, "name");
-    json_builder_add_string_value (builder, store_app_get_name (self));
-    json_builder_set_member_name (builder, "publisher");
-    json_builder_add_string_value (builder, store_app_get_publisher (self));
-    json_builder_set_member_name (builder, "publisher-validated");
-    json_builder_add_boolean_value (builder, store_app_get_publisher_validated (self));
-    json_builder_set_member_name (builder, "screenshots");
-    json_builder_begin_array (builder);
+    json_builder_set_member_name (details_builder, "screenshots");
+    json_builder_begin_array (details_builder);
     GPtrArray *screenshots = store_app_get_screenshots (self);
     for (guint i = 0; i < screenshots->len; i++) {
         StoreMedia *screenshot = g_ptr_array_index (screenshots, i);
-        json_builder_add_value (builder, store_media_to_json (screenshot));
+        json_builder_add_value (details_builder, store_media_to_json (screenshot));
     }
-    json_builder_end_array (builder);
-    json_builder_set_member_name (builder, "summary");
-    json_builder_add_string_value (builder, store_app_get_summary (self));
-    json_builder_set_member_name (builder, "title");
-    json_builder_add_string_value (builder, store_app_get_title (self));
-    json_builder_set_member_name (builder, "version");
-    json_builder_add_string_value (builder, store_app_get_version (self));
-    json_builder_end_object (builder);
+    json_builder_end_array (details_builder);
+    json_builder_end_object (details_builder);
 
-    g_autoptr(JsonNode) node = json_builder_get_root (builder);
-    store_cache_insert_json (cache, "snaps", store_app_get_name (self), FALSE, node, NULL, NULL);
+    g_autoptr(JsonNode) details_node = json_builder_get_root (details_builder);
+    store_cache_insert_json (cache, "snap-details", store_app_get_name (self), FALSE, details_node, NULL, NULL);
 }
 
 static void
-store_snap_app_update_from_cache (StoreApp *self, StoreCache *cache)
+store_snap_app_update_details_from_cache (StoreApp *self, StoreCache *cache)
 {
     const gchar *name = store_app_get_name (STORE_APP (self));
-    g_autoptr(JsonNode) node = store_cache_lookup_json (cache, "snaps", name, FALSE, NULL, NULL);
+    g_autoptr(JsonNode) node = store_cache_lookup_json (cache, "snap-details", name, FALSE, NULL, NULL);
     if (node == NULL)
         return;
 
     JsonObject *object = json_node_get_object (node);
-    store_app_set_appstream_id (STORE_APP (self), json_object_get_string_member (object, "appstream-id")); // FIXME: Move common fields into StoreApp
-    if (json_object_has_member (object, "banner")) {
-        g_autoptr(StoreMedia) banner = store_media_new_from_json (json_object_get_member (object, "banner"));
-        store_app_set_banner (STORE_APP (self), banner);
-    }
     if (json_object_has_member (object, "channels")) {
         g_autoptr(GPtrArray) channels = g_ptr_array_new_with_free_func (g_object_unref);
         JsonArray *channels_array = json_object_get_array_member (object, "channels");
@@ -283,15 +268,8 @@ store_snap_app_update_from_cache (StoreApp *self, StoreCache *cache)
     if (json_object_has_member (object, "contact"))
         store_app_set_contact (STORE_APP (self), json_object_get_string_member (object, "contact"));
     store_app_set_description (STORE_APP (self), json_object_get_string_member (object, "description"));
-    if (json_object_has_member (object, "icon")) {
-        g_autoptr(StoreMedia) icon = store_media_new_from_json (json_object_get_member (object, "icon"));
-        store_app_set_icon (STORE_APP (self), icon);
-    }
     if (json_object_has_member (object, "license"))
         store_app_set_license (STORE_APP (self), json_object_get_string_member (object, "license"));
-    store_app_set_name (STORE_APP (self), json_object_get_string_member (object, "name"));
-    store_app_set_publisher (STORE_APP (self), json_object_get_string_member (object, "publisher"));
-    store_app_set_publisher_validated (STORE_APP (self), json_object_get_boolean_member (object, "publisher-validated"));
     g_autoptr(GPtrArray) screenshots = g_ptr_array_new_with_free_func (g_object_unref);
     JsonArray *screenshots_array = json_object_get_array_member (object, "screenshots");
     for (guint i = 0; i < json_array_get_length (screenshots_array); i++) {
@@ -300,10 +278,17 @@ store_snap_app_update_from_cache (StoreApp *self, StoreCache *cache)
         g_ptr_array_add (screenshots, g_steal_pointer (&screenshot));
     }
     store_app_set_screenshots (STORE_APP (self), screenshots);
-    store_app_set_summary (STORE_APP (self), json_object_get_string_member (object, "summary"));
-    store_app_set_title (STORE_APP (self), json_object_get_string_member (object, "title"));
-    if (json_object_has_member (object, "version"))
-        store_app_set_version (STORE_APP (self), json_object_get_string_member (object, "version"));
+}
+
+static void
+store_snap_app_update_from_cache (StoreApp *self, StoreCache *cache)
+{
+    const gchar *name = store_app_get_name (STORE_APP (self));
+    g_autoptr(JsonNode) node = store_cache_lookup_json (cache, "snaps", name, FALSE, NULL, NULL);
+    if (node == NULL)
+        return;
+
+    store_snap_app_update_from_json (STORE_SNAP_APP (self), node);
 }
 
 static void
@@ -318,6 +303,7 @@ store_snap_app_class_init (StoreSnapAppClass *klass)
     STORE_APP_CLASS (klass)->remove_async = store_snap_app_remove_async;
     STORE_APP_CLASS (klass)->remove_finish = store_snap_app_remove_finish;
     STORE_APP_CLASS (klass)->save_to_cache = store_snap_app_save_to_cache;
+    STORE_APP_CLASS (klass)->update_details_from_cache = store_snap_app_update_details_from_cache;
     STORE_APP_CLASS (klass)->update_from_cache = store_snap_app_update_from_cache;
 }
 
@@ -362,6 +348,8 @@ store_snap_app_update_from_search (StoreSnapApp *self, SnapdSnap *snap)
 {
     g_return_if_fail (STORE_IS_SNAP_APP (self));
 
+    g_object_freeze_notify (G_OBJECT (self));
+
     store_app_set_name (STORE_APP (self), snapd_snap_get_name (snap));
     if (snapd_snap_get_title (snap) != NULL)
         store_app_set_title (STORE_APP (self), snapd_snap_get_title (snap));
@@ -438,4 +426,73 @@ store_snap_app_update_from_search (StoreSnapApp *self, SnapdSnap *snap)
 
     g_autofree gchar *appstream_id = g_strdup_printf ("io.snapcraft.%s-%s", snapd_snap_get_name (snap), snapd_snap_get_id (snap));
     store_app_set_appstream_id (STORE_APP (self), appstream_id);
+
+    g_object_thaw_notify (G_OBJECT (self));
+}
+
+/* Update from a "snaps" cache entry that has already been read, e.g. in another thread */
+void
+store_snap_app_update_from_json (StoreSnapApp *self, JsonNode *node)
+{
+    g_return_if_fail (STORE_IS_SNAP_APP (self));
+
+    if (!JSON_NODE_HOLDS_OBJECT (node))
+        return;
+
+    g_object_freeze_notify (G_OBJECT (self));
+
+    JsonObject *object = json_node_get_object (node);
+    store_app_set_appstream_id (STORE_APP (self), json_object_get_string_member (object, "appstream-id")); // FIXME: Move common fields into StoreApp
+    if (json_object_has_member (object, "banner")) {
+        g_autoptr(StoreMedia) banner = store_media_new_from_json (json_object_get_member (object, "banner"));
+        store_app_set_banner (STORE_APP (self), banner);
+    }
+    if (json_object_has_member (object, "icon")) {
+        g_autoptr(StoreMedia) icon = store_media_new_from_json (json_object_get_member (object, "icon"));
+        store_app_set_icon (STORE_APP (self), icon);
+    }
+    store_app_set_name (STORE_APP (self), json_object_get_string_member (object, "name"));
+    store_app_set_publisher (STORE_APP (self), json_object_get_string_member (object, "publisher"));
+    store_app_set_publisher_validated (STORE_APP (self), json_object_get_boolean_member (object, "publisher-validated"));
+    store_app_set_summary (STORE_APP (self), json_object_get_string_member (object, "summary"));
+    store_app_set_title (STORE_APP (self), json_object_get_string_member (object, "title"));
+    if (json_object_has_member (object, "version"))
+        store_app_set_version (STORE_APP (self), json_object_get_string_member (object, "version"));
+
+    g_object_thaw_notify (G_OBJECT (self));
+}
+
+/* The fields shown in tiles, as stored in the "snaps" cache entries */
+JsonNode *
+store_snap_app_to_json (StoreSnapApp *self)
+{
+    g_return_val_if_fail (STORE_IS_SNAP_APP (self), NULL);
+
+    g_autoptr(JsonBuilder) builder = json_builder_new ();
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "appstream-id"); // FIXME: Move common fields into StoreApp
+    json_builder_add_string_value (builder, store_app_get_appstream_id (STORE_APP (self)));
+    if (store_app_get_banner (STORE_APP (self)) != NULL) {
+        json_builder_set_member_name (builder, "banner");
+        json_builder_add_value (builder, store_media_to_json (store_app_get_banner (STORE_APP (self))));
+    }
+    if (store_app_get_icon (STORE_APP (self)) != NULL) {
+        json_builder_set_member_name (builder, "icon");
+        json_builder_add_value (builder, store_media_to_json (store_app_get_icon (STORE_APP (self))));
+    }
+    json_builder_set_member_name (builder, "name");
+    json_builder_add_string_value (builder, store_app_get_name (STORE_APP (self)));
+    json_builder_set_member_name (builder, "publisher");
+    json_builder_add_string_value (builder, store_app_get_publisher (STORE_APP (self)));
+    json_builder_set_member_name (builder, "publisher-validated");
+    json_builder_add_boolean_value (builder, store_app_get_publisher_validated (STORE_APP (self)));
+    json_builder_set_member_name (builder, "summary");
+    json_builder_add_string_value (builder, store_app_get_summary (STORE_APP (self)));
+    json_builder_set_member_name (builder, "title");
+    json_builder_add_string_value (builder, store_app_get_title (STORE_APP (self)));
+    json_builder_set_member_name (builder, "version");
+    json_builder_add_string_value (builder, store_app_get_version (STORE_APP (self)));
+    json_builder_end_object (builder);
+
+    return json_builder_get_root (builder);
 }
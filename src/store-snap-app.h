@@ -23,4 +23,8 @@ void          store_snap_app_set_snapd_socket_path (StoreSnapApp *app, const gch
 
 void          store_snap_app_update_from_search    (StoreSnapApp *app, SnapdSnap *snap);
 
+void          store_snap_app_update_from_json      (StoreSnapApp *app, JsonNode *node);
+
+JsonNode     *store_snap_app_to_json               (StoreSnapApp *app);
+
 G_END_DECLS
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "store-tile-reconciler.h"
+
+struct _StoreTileReconciler
+{
+    GObject parent_instance;
+
+    StoreTileGetItemFunc get_item;
+    StoreTileNewFunc new_tile;
+    StoreTileSetItemFunc set_item;
+    gpointer user_data;
+};
+
+G_DEFINE_TYPE (StoreTileReconciler, store_tile_reconciler, G_TYPE_OBJECT)
+
+static void
+store_tile_reconciler_class_init (StoreTileReconcilerClass *klass G_GNUC_UNUSED)
+{
+}
+
+static void
+store_tile_reconciler_init (StoreTileReconciler *self G_GNUC_UNUSED)
+{
+}
+
+StoreTileReconciler *
+store_tile_reconciler_new (StoreTileNewFunc new_tile, StoreTileGetItemFunc get_item, StoreTileSetItemFunc set_item, gpointer user_data)
+{
+    StoreTileReconciler *self = g_object_new (store_tile_reconciler_get_type (), NULL);
+
+    self->get_item = get_item;
+    self->new_tile = new_tile;
+    self->set_item = set_item;
+    self->user_data = user_data;
+
+    return self;
+}
+
+/* Returns the tiles to show items @start to @end, in order.
+ * Tiles already showing one of the items are kept as they are, the others are given the remaining items and new tiles are only made when
+ * there are none left. Tiles that are not needed are added to @unused_tiles */
+GPtrArray *
+store_tile_reconciler_reconcile (StoreTileReconciler *self, GPtrArray *tiles, GListModel *items, guint start, guint end, GPtrArray *unused_tiles)
+{
+    g_return_val_if_fail (STORE_IS_TILE_RECONCILER (self), NULL);
+
+    guint n_items = items != NULL ? g_list_model_get_n_items (items) : 0;
+    end = MIN (end, n_items);
+    start = MIN (start, end);
+
+    /* Find which tile shows each item */
+    g_autoptr(GHashTable) tiles_by_item = g_hash_table_new (g_direct_hash, g_direct_equal);
+    for (guint i = 0; tiles != NULL && i < tiles->len; i++) {
+        GtkWidget *tile = g_ptr_array_index (tiles, i);
+        GObject *item = self->get_item (tile);
+        if (item != NULL && !g_hash_table_contains (tiles_by_item, item))
+            g_hash_table_insert (tiles_by_item, item, tile);
+    }
+
+    GPtrArray *result = g_ptr_array_sized_new (end - start);
+    g_autoptr(GPtrArray) result_items = g_ptr_array_new_full (end - start, g_object_unref);
+    g_autoptr(GHashTable) used_tiles = g_hash_table_new (g_direct_hash, g_direct_equal);
+    for (guint i = start; i < end; i++) {
+        GObject *item = g_list_model_get_item (items, i);
+        g_ptr_array_add (result_items, item);
+
+        GtkWidget *tile = g_hash_table_lookup (tiles_by_item, item);
+        if (tile != NULL) {
+            /* An item shown twice only keeps one tile */
+            g_hash_table_remove (tiles_by_item, item);
+            g_hash_table_add (used_tiles, tile);
+        }
+        g_ptr_array_add (result, tile);
+    }
+
+    /* Give the remaining tiles to the items without one */
+    guint next_tile = 0;
+    for (guint i = 0; i < result->len; i++) {
+        if (g_ptr_array_index (result, i) != NULL)
+            continue;
+
+        GtkWidget *tile = NULL;
+        while (tiles != NULL && next_tile < tiles->len && tile == NULL) {
+            GtkWidget *t = g_ptr_array_index (tiles, next_tile);
+            next_tile++;
+            if (!g_hash_table_contains (used_tiles, t))
+                tile = t;
+        }
+        if (tile == NULL)
+            tile = self->new_tile (self->user_data);
+        self->set_item (tile, g_ptr_array_index (result_items, i));
+        g_hash_table_add (used_tiles, tile);
+        g_ptr_array_index (result, i) = tile;
+    }
+
+    for (; unused_tiles != NULL && tiles != NULL && next_tile < tiles->len; next_tile++) {
+        GtkWidget *tile = g_ptr_array_index (tiles, next_tile);
+        if (!g_hash_table_contains (used_tiles, tile))
+            g_ptr_array_add (unused_tiles, tile);
+    }
+
+    return result;
+}
+
+/* Make the children of @box show the first @max_items items. Returns TRUE if any child changed */
+gboolean
+store_tile_reconciler_update_box (StoreTileReconciler *self, GtkBox *box, GListModel *items, guint max_items)
+{
+    g_return_val_if_fail (STORE_IS_TILE_RECONCILER (self), FALSE);
+
+    g_autoptr(GList) children = gtk_container_get_children (GTK_CONTAINER (box));
+    g_autoptr(GPtrArray) tiles = g_ptr_array_new ();
+    for (GList *link = children; link != NULL; link = link->next)
+        g_ptr_array_add (tiles, link->data);
+
+    g_autoptr(GPtrArray) unused_tiles = g_ptr_array_new ();
+    g_autoptr(GPtrArray) new_tiles = store_tile_reconciler_reconcile (self, tiles, items, 0, max_items, unused_tiles);
+
+    gboolean changed = FALSE;
+    for (guint i = 0; i < unused_tiles->len; i++) {
+        gtk_widget_destroy (g_ptr_array_index (unused_tiles, i));
+        changed = TRUE;
+    }
+    for (guint i = 0; i < new_tiles->len; i++) {
+        GtkWidget *tile = g_ptr_array_index (new_tiles, i);
+        if (gtk_widget_get_parent (tile) == NULL) {
+            gtk_container_add (GTK_CONTAINER (box), tile);
+            changed = TRUE;
+        }
+    }
+
+    /* Only move the tiles that are out of place */
+    g_autoptr(GList) new_children = gtk_container_get_children (GTK_CONTAINER (box));
+    g_autoptr(GHashTable) placed_tiles = g_hash_table_new (g_direct_hash, g_direct_equal);
+    GList *link = new_children;
+    for (guint i = 0; i < new_tiles->len; i++) {
+        GtkWidget *tile = g_ptr_array_index (new_tiles, i);
+
+        while (link != NULL && g_hash_table_contains (placed_tiles, link->data))
+            link = link->next;
+        if (link != NULL && link->data == tile)
+            link = link->next;
+        else {
+            gtk_box_reorder_child (box, tile, i);
+            changed = TRUE;
+        }
+        g_hash_table_add (placed_tiles, tile);
+    }
+
+    return changed;
+}
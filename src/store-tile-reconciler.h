@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE (StoreTileReconciler, store_tile_reconciler, STORE, TILE_RECONCILER, GObject)
+
+typedef GtkWidget *(*StoreTileNewFunc)     (gpointer user_data);
+
+typedef GObject   *(*StoreTileGetItemFunc) (GtkWidget *tile);
+
+typedef void       (*StoreTileSetItemFunc) (GtkWidget *tile, GObject *item);
+
+StoreTileReconciler *store_tile_reconciler_new        (StoreTileNewFunc new_tile, StoreTileGetItemFunc get_item, StoreTileSetItemFunc set_item, gpointer user_data);
+
+GPtrArray           *store_tile_reconciler_reconcile  (StoreTileReconciler *reconciler, GPtrArray *tiles, GListModel *items, guint start, guint end,
+                                                       GPtrArray *unused_tiles);
+
+gboolean             store_tile_reconciler_update_box (StoreTileReconciler *reconciler, GtkBox *box, GListModel *items, guint max_items);
+
+G_END_DECLS
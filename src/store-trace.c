@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <json-glib/json-glib.h>
+#include <unistd.h>
+
+#include "store-trace.h"
+
+/* Events are written in the Chrome trace format, which can be loaded into chrome://tracing or https://ui.perfetto.dev */
+
+struct _StoreTraceSpan
+{
+    gboolean async;
+    const gchar *category;
+    gchar *detail;
+    const gchar *name;
+    gint64 start_time;
+    guint thread_id;
+};
+
+typedef struct
+{
+    const gchar *category;
+    gchar *detail;
+    gint64 duration;
+    guint id;
+    const gchar *name;
+    gchar phase;
+    guint thread_id;
+    gint64 time;
+} TraceEvent;
+
+static GArray *events = NULL;
+static GMutex events_mutex;
+static gint next_async_id = 1;
+static gint next_thread_id = 1;
+static gchar *path = NULL;
+static gint64 start_time = 0;
+static GPrivate thread_id_key;
+
+static guint
+get_thread_id (void)
+{
+    guint id = GPOINTER_TO_UINT (g_private_get (&thread_id_key));
+    if (id == 0) {
+        id = g_atomic_int_add (&next_thread_id, 1);
+        g_private_set (&thread_id_key, GUINT_TO_POINTER (id));
+    }
+    return id;
+}
+
+static void
+trace_event_clear (TraceEvent *event)
+{
+    g_clear_pointer (&event->detail, g_free);
+}
+
+static void
+add_event (gchar phase, const gchar *category, const gchar *name, const gchar *detail, guint thread_id, gint64 time, gint64 duration, guint id)
+{
+    TraceEvent event = { 0 };
+    event.category = category;
+    event.detail = g_strdup (detail);
+    event.duration = duration;
+    event.id = id;
+    event.name = name;
+    event.phase = phase;
+    event.thread_id = thread_id;
+    event.time = time - start_time;
+
+    g_mutex_lock (&events_mutex);
+    g_array_append_val (events, event);
+    g_mutex_unlock (&events_mutex);
+}
+
+/* Called first thing on startup so times are relative to launch. Tracing is enabled if SNAP_STORE_TRACE is set to the file to write to */
+void
+store_trace_init (void)
+{
+    start_time = g_get_monotonic_time ();
+
+    const gchar *trace_path = g_getenv ("SNAP_STORE_TRACE");
+    if (trace_path != NULL && trace_path[0] != '\0')
+        store_trace_enable (trace_path);
+}
+
+void
+store_trace_enable (const gchar *trace_path)
+{
+    g_mutex_lock (&events_mutex);
+    if (events == NULL) {
+        events = g_array_new (FALSE, TRUE, sizeof (TraceEvent));
+        g_array_set_clear_func (events, (GDestroyNotify) trace_event_clear);
+    }
+    g_free (path);
+    path = g_strdup (trace_path);
+    g_mutex_unlock (&events_mutex);
+
+    if (start_time == 0)
+        start_time = g_get_monotonic_time ();
+}
+
+gboolean
+store_trace_get_enabled (void)
+{
+    return events != NULL;
+}
+
+static StoreTraceSpan *
+begin_span (gboolean async, const gchar *category, const gchar *name, const gchar *detail)
+{
+    if (events == NULL)
+        return NULL;
+
+    StoreTraceSpan *span = g_new0 (StoreTraceSpan, 1);
+    span->async = async;
+    span->category = category;
+    span->detail = g_strdup (detail);
+    span->name = name;
+    span->start_time = g_get_monotonic_time ();
+    span->thread_id = get_thread_id ();
+
+    return span;
+}
+
+/* Start a span that ends in the same function. @category and @name must be static strings.
+ * Returns NULL if tracing is disabled */
+StoreTraceSpan *
+store_trace_begin (const gchar *category, const gchar *name, const gchar *detail)
+{
+    return begin_span (FALSE, category, name, detail);
+}
+
+/* Start a span that ends in a callback, and so may overlap other spans */
+StoreTraceSpan *
+store_trace_begin_async (const gchar *category, const gchar *name, const gchar *detail)
+{
+    return begin_span (TRUE, category, name, detail);
+}
+
+void
+store_trace_end (StoreTraceSpan *span)
+{
+    if (span == NULL)
+        return;
+
+    gint64 end_time = g_get_monotonic_time ();
+    if (span->async) {
+        guint id = g_atomic_int_add (&next_async_id, 1);
+        add_event ('b', span->category, span->name, span->detail, span->thread_id, span->start_time, 0, id);
+        add_event ('e', span->category, span->name, NULL, get_thread_id (), end_time, 0, id);
+    }
+    else
+        add_event ('X', span->category, span->name, span->detail, span->thread_id, span->start_time, end_time - span->start_time, 0);
+
+    g_free (span->detail);
+    g_free (span);
+}
+
+/* Trace an asynchronous operation for the life of @object, e.g. the GTask passed to its callback */
+void
+store_trace_begin_object (gpointer object, const gchar *category, const gchar *name, const gchar *detail)
+{
+    StoreTraceSpan *span = store_trace_begin_async (category, name, detail);
+    if (span != NULL)
+        g_object_set_data_full (G_OBJECT (object), "store-trace-span", span, (GDestroyNotify) store_trace_end);
+}
+
+/* End the span started with store_trace_begin_object() if it has not already ended */
+void
+store_trace_end_object (gpointer object)
+{
+    store_trace_end (g_object_steal_data (G_OBJECT (object), "store-trace-span"));
+}
+
+void
+store_trace_mark (const gchar *category, const gchar *name)
+{
+    if (events == NULL)
+        return;
+
+    add_event ('i', category, name, NULL, get_thread_id (), g_get_monotonic_time (), 0, 0);
+}
+
+gboolean
+store_trace_write (GError **error)
+{
+    if (events == NULL)
+        return TRUE;
+
+    g_autoptr(JsonBuilder) builder = json_builder_new ();
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "displayTimeUnit");
+    json_builder_add_string_value (builder, "ms");
+    json_builder_set_member_name (builder, "traceEvents");
+    json_builder_begin_array (builder);
+    g_mutex_lock (&events_mutex);
+    for (guint i = 0; i < events->len; i++) {
+        TraceEvent *event = &g_array_index (events, TraceEvent, i);
+        gchar phase[2] = { event->phase, '\0' };
+
+        json_builder_begin_object (builder);
+        json_builder_set_member_name (builder, "cat");
+        json_builder_add_string_value (builder, event->category);
+        json_builder_set_member_name (builder, "name");
+        json_builder_add_string_value (builder, event->name);
+        json_builder_set_member_name (builder, "ph");
+        json_builder_add_string_value (builder, phase);
+        json_builder_set_member_name (builder, "pid");
+        json_builder_add_int_value (builder, getpid ());
+        json_builder_set_member_name (builder, "tid");
+        json_builder_add_int_value (builder, event->thread_id);
+        json_builder_set_member_name (builder, "ts");
+        json_builder_add_int_value (builder, event->time);
+        if (event->phase == 'X') {
+            json_builder_set_member_name (builder, "dur");
+            json_builder_add_int_value (builder, event->duration);
+        }
+        if (event->phase == 'b' || event->phase == 'e') {
+            json_builder_set_member_name (builder, "id");
+            json_builder_add_int_value (builder, event->id);
+        }
+        if (event->phase == 'i') {
+            json_builder_set_member_name (builder, "s");
+            json_builder_add_string_value (builder, "g");
+        }
+        if (event->detail != NULL) {
+            json_builder_set_member_name (builder, "args");
+            json_builder_begin_object (builder);
+            json_builder_set_member_name (builder, "detail");
+            json_builder_add_string_value (builder, event->detail);
+            json_builder_end_object (builder);
+        }
+        json_builder_end_object (builder);
+    }
+    g_mutex_unlock (&events_mutex);
+    json_builder_end_array (builder);
+    json_builder_end_object (builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new ();
+    g_autoptr(JsonNode) root = json_builder_get_root (builder);
+    json_generator_set_root (generator, root);
+    return json_generator_to_file (generator, path, error);
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+typedef struct _StoreTraceSpan StoreTraceSpan;
+
+void            store_trace_init          (void);
+
+void            store_trace_enable        (const gchar *path);
+
+gboolean        store_trace_get_enabled   (void);
+
+StoreTraceSpan *store_trace_begin         (const gchar *category, const gchar *name, const gchar *detail);
+
+StoreTraceSpan *store_trace_begin_async   (const gchar *category, const gchar *name, const gchar *detail);
+
+void            store_trace_end           (StoreTraceSpan *span);
+
+void            store_trace_begin_object  (gpointer object, const gchar *category, const gchar *name, const gchar *detail);
+
+void            store_trace_end_object    (gpointer object);
+
+void            store_trace_mark          (const gchar *category, const gchar *name);
+
+gboolean        store_trace_write         (GError **error);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (StoreTraceSpan, store_trace_end)
+
+G_END_DECLS
@@ -30,12 +30,20 @@ struct _StoreWindow
     StoreInstalledPage *installed_page;
     GtkStack *stack;
 
+    StoreFrameProfiler *frame_profiler;
     StoreModel *model;
     GList *page_stack;
 };
 
 G_DEFINE_TYPE (StoreWindow, store_window, GTK_TYPE_APPLICATION_WINDOW)
 
+static void
+begin_transition (StoreWindow *self, GtkWidget *page, const gchar *detail)
+{
+    if (self->frame_profiler != NULL)
+        store_frame_profiler_begin_transition (self->frame_profiler, page, detail);
+}
+
 static void
 app_activated_cb (StoreWindow *self, StoreApp *app)
 {
@@ -55,6 +63,7 @@ back_button_clicked_cb (StoreWindow *self)
     if (page == NULL)
         page = GTK_WIDGET (self->home_page);
     self->page_stack = g_list_delete_link (self->page_stack, g_list_first (self->page_stack));
+    begin_transition (self, page, NULL);
     gtk_stack_set_visible_child (self->stack, page);
     gtk_widget_set_visible (GTK_WIDGET (self->back_button), self->page_stack != NULL);
 }
@@ -65,12 +74,15 @@ page_toggled_cb (StoreWindow *self, GtkToggleButton *button)
     if (!gtk_toggle_button_get_active (button))
         return;
 
+    GtkWidget *page;
     if (button == self->home_button)
-        gtk_stack_set_visible_child (self->stack, GTK_WIDGET (self->home_page));
+        page = GTK_WIDGET (self->home_page);
     else if (button == self->categories_button)
-        gtk_stack_set_visible_child (self->stack, GTK_WIDGET (self->category_home_page));
-    else if (button == self->installed_button)
-        gtk_stack_set_visible_child (self->stack, GTK_WIDGET (self->installed_page));
+        page = GTK_WIDGET (self->category_home_page);
+    else
+        page = GTK_WIDGET (self->installed_page);
+    begin_transition (self, page, NULL);
+    gtk_stack_set_visible_child (self->stack, page);
     g_clear_pointer (&self->page_stack, g_list_free);
     gtk_widget_hide (GTK_WIDGET (self->back_button));
 
@@ -87,6 +99,7 @@ store_window_dispose (GObject *object)
 {
     StoreWindow *self = STORE_WINDOW (object);
 
+    g_clear_object (&self->frame_profiler);
     g_clear_object (&self->model);
     g_clear_pointer (&self->page_stack, g_list_free);
 
@@ -152,6 +165,13 @@ store_window_set_model (StoreWindow *self, StoreModel *model)
     store_page_set_model (STORE_PAGE (self->installed_page), model);
 }
 
+void
+store_window_set_frame_profiler (StoreWindow *self, StoreFrameProfiler *profiler)
+{
+    g_return_if_fail (STORE_IS_WINDOW (self));
+    g_set_object (&self->frame_profiler, profiler);
+}
+
 void
 store_window_load (StoreWindow *self)
 {
@@ -168,6 +188,7 @@ store_window_show_app (StoreWindow *self, StoreApp *app)
 
     self->page_stack = g_list_prepend (self->page_stack, gtk_stack_get_visible_child (self->stack));
 
+    begin_transition (self, GTK_WIDGET (self->app_page), store_app_get_name (app));
     store_app_page_set_app (self->app_page, app);
     gtk_stack_set_visible_child (self->stack, GTK_WIDGET (self->app_page)); // FIXME: Buttons
     gtk_widget_show (GTK_WIDGET (self->back_button));
@@ -180,6 +201,7 @@ store_window_show_category (StoreWindow *self, StoreCategory *category)
 
     self->page_stack = g_list_prepend (self->page_stack, gtk_stack_get_visible_child (self->stack));
 
+    begin_transition (self, GTK_WIDGET (self->category_page), store_category_get_name (category));
     store_category_page_set_category (self->category_page, category);
     gtk_stack_set_visible_child (self->stack, GTK_WIDGET (self->category_page)); // FIXME: Buttons
     gtk_widget_show (GTK_WIDGET (self->back_button));
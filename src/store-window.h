@@ -14,20 +14,23 @@
 #include "store-app.h"
 #include "store-application.h"
 #include "store-category.h"
+#include "store-frame-profiler.h"
 #include "store-model.h"
 
 G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (StoreWindow, store_window, STORE, WINDOW, GtkApplicationWindow)
 
-StoreWindow *store_window_new           (StoreApplication *application);
+StoreWindow *store_window_new                (StoreApplication *application);
 
-void         store_window_set_model     (StoreWindow *window, StoreModel *model);
+void         store_window_set_model          (StoreWindow *window, StoreModel *model);
 
-void         store_window_load          (StoreWindow *self);
+void         store_window_set_frame_profiler (StoreWindow *window, StoreFrameProfiler *profiler);
 
-void         store_window_show_app      (StoreWindow *self, StoreApp *app);
+void         store_window_load               (StoreWindow *self);
 
-void         store_window_show_category (StoreWindow *self, StoreCategory *category);
+void         store_window_show_app           (StoreWindow *self, StoreApp *app);
+
+void         store_window_show_category      (StoreWindow *self, StoreCategory *category);
 
 G_END_DECLS
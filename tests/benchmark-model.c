@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include "mock-catalogue.h"
+#include "mock-odrs-server.h"
+#include "mock-snapd.h"
+#include "store-model.h"
+
+/* Drives StoreModel against in-process mock snapd and ODRS servers without a display.
+ * The servers run in their own threads so only the model's work is counted */
+
+typedef enum
+{
+    OPERATION_CATEGORY_REFRESH,
+    OPERATION_SEARCH,
+    OPERATION_INSTALLED_REFRESH,
+    OPERATION_RATINGS_UPDATE,
+    OPERATION_REVIEWS,
+    OPERATION_IMAGE_FETCH,
+    OPERATION_LAST
+} Operation;
+
+static const gchar *operation_names[] =
+{
+    "category-refresh",
+    "search",
+    "installed-refresh",
+    "ratings-update",
+    "reviews",
+    "image-fetch"
+};
+
+typedef struct
+{
+    guint64 allocations;
+    GArray *times;
+} Measurements;
+
+typedef struct
+{
+    GCond condition;
+    GError *error;
+    guint image_port;
+    GMainLoop *loop;
+    GMutex mutex;
+    guint odrs_port;
+    gboolean started;
+} HttpServers;
+
+/* Number of reviews and image fetches made in each iteration */
+#define REVIEWS_PER_ITERATION 5
+#define IMAGES_PER_ITERATION 10
+
+/* Most reviews any app has */
+#define MAX_REVIEWS 200
+
+/* Seconds to wait for the category apps after the categories are returned */
+#define CATEGORY_APPS_TIMEOUT 60
+
+static gint n_snaps = 5000;
+static gint n_sections = 50;
+static gint n_installed = 200;
+static gint n_iterations = 10;
+static gint n_rated_apps = 50000;
+static gint snapd_delay = 0;
+static gint snapd_bandwidth = 0;
+static gint odrs_delay = 0;
+static gint odrs_bandwidth = 0;
+
+static Measurements measurements[OPERATION_LAST];
+static gint64 operation_start_time = 0;
+static guint64 operation_start_allocations = 0;
+
+#ifdef __GLIBC__
+/* Count allocations on the thread running the model by wrapping the glibc allocator */
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t n_members, size_t size);
+extern void *__libc_realloc (void *mem, size_t size);
+
+static _Thread_local gboolean count_allocations = FALSE;
+static guint64 n_allocations = 0;
+
+void *
+malloc (size_t size)
+{
+    if (count_allocations)
+        n_allocations++;
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t n_members, size_t size)
+{
+    if (count_allocations)
+        n_allocations++;
+    return __libc_calloc (n_members, size);
+}
+
+void *
+realloc (void *mem, size_t size)
+{
+    if (count_allocations)
+        n_allocations++;
+    return __libc_realloc (mem, size);
+}
+#else
+static gboolean count_allocations = FALSE;
+static guint64 n_allocations = 0;
+#endif
+
+static GBytes *
+make_image (gint width, gint height)
+{
+    g_autoptr(GdkPixbuf) pixbuf = gdk_pixbuf_new (GDK_COLORSPACE_RGB, FALSE, 8, width, height);
+    guchar *pixels = gdk_pixbuf_get_pixels (pixbuf);
+    gint rowstride = gdk_pixbuf_get_rowstride (pixbuf);
+    for (gint y = 0; y < height; y++) {
+        for (gint x = 0; x < width; x++) {
+            guchar *p = pixels + y * rowstride + x * 3;
+            p[0] = x * 255 / width;
+            p[1] = y * 255 / height;
+            p[2] = (x ^ y) & 0xFF;
+        }
+    }
+
+    gchar *data;
+    gsize data_length;
+    g_autoptr(GError) error = NULL;
+    if (!gdk_pixbuf_save_to_buffer (pixbuf, &data, &data_length, "png", &error, NULL))
+        g_error ("Failed to make image: %s", error->message);
+
+    return g_bytes_new_take (data, data_length);
+}
+
+static void
+image_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *path G_GNUC_UNUSED, GHashTable *query G_GNUC_UNUSED, SoupClientContext *context G_GNUC_UNUSED, gpointer user_data)
+{
+    GBytes *image = user_data;
+
+    if (msg->method != SOUP_METHOD_GET) {
+        soup_message_set_status (msg, SOUP_STATUS_NOT_IMPLEMENTED);
+        return;
+    }
+
+    soup_message_set_status (msg, SOUP_STATUS_OK);
+    soup_message_set_response (msg, "image/png", SOUP_MEMORY_COPY, g_bytes_get_data (image, NULL), g_bytes_get_size (image));
+}
+
+static guint
+get_server_port (SoupServer *server)
+{
+    GSList *uris = soup_server_get_uris (server);
+
+    guint port = 0;
+    for (GSList *link = uris; link != NULL; link = link->next) {
+        SoupURI *uri = link->data;
+        port = soup_uri_get_port (uri);
+    }
+
+    g_slist_free_full (uris, (GDestroyNotify) soup_uri_free);
+
+    return port;
+}
+
+static gpointer
+http_thread (gpointer user_data)
+{
+    HttpServers *servers = user_data;
+
+    g_autoptr(GMainContext) context = g_main_context_new ();
+    g_main_context_push_thread_default (context);
+
+    g_autoptr(SoupServer) image_server = soup_server_new (SOUP_SERVER_SERVER_HEADER, "mock-images", NULL);
+    g_autoptr(GBytes) icon = make_image (256, 256);
+    g_autoptr(GBytes) screenshot = make_image (1280, 720);
+    soup_server_add_handler (image_server, "/icon", image_cb, icon, NULL);
+    soup_server_add_handler (image_server, "/screenshot", image_cb, screenshot, NULL);
+
+    g_autoptr(MockOdrsServer) odrs_server = mock_odrs_server_new ();
+    mock_odrs_server_generate_apps (odrs_server, MAX (n_rated_apps, n_snaps), MAX_REVIEWS);
+    mock_odrs_server_set_delay (odrs_server, odrs_delay);
+    mock_odrs_server_set_bandwidth (odrs_server, odrs_bandwidth);
+
+    g_autoptr(GError) error = NULL;
+    gboolean result = soup_server_listen_local (image_server, 0, 0, &error) &&
+                      mock_odrs_server_start (odrs_server, &error);
+
+    g_mutex_lock (&servers->mutex);
+    if (result) {
+        servers->image_port = get_server_port (image_server);
+        servers->odrs_port = mock_odrs_server_get_port (odrs_server);
+        servers->loop = g_main_loop_new (context, FALSE);
+    }
+    else
+        servers->error = g_steal_pointer (&error);
+    servers->started = TRUE;
+    g_cond_signal (&servers->condition);
+    g_mutex_unlock (&servers->mutex);
+
+    if (result)
+        g_main_loop_run (servers->loop);
+
+    g_main_context_pop_thread_default (context);
+
+    return NULL;
+}
+
+static gboolean
+quit_cb (gpointer user_data)
+{
+    g_main_loop_quit (user_data);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+begin_operation (void)
+{
+    operation_start_allocations = n_allocations;
+    operation_start_time = g_get_monotonic_time ();
+}
+
+static void
+end_operation (Operation operation)
+{
+    gint64 time = g_get_monotonic_time () - operation_start_time;
+    g_array_append_val (measurements[operation].times, time);
+    measurements[operation].allocations += n_allocations - operation_start_allocations;
+}
+
+static void
+result_cb (GObject *object G_GNUC_UNUSED, GAsyncResult *result, gpointer user_data)
+{
+    GAsyncResult **r = user_data;
+    *r = g_object_ref (result);
+}
+
+static void
+wait_for_result (GAsyncResult **result)
+{
+    while (*result == NULL)
+        g_main_context_iteration (NULL, TRUE);
+}
+
+/* Category apps are fetched after the categories are returned */
+static gboolean
+categories_loaded (StoreModel *model)
+{
+    GPtrArray *categories = store_model_get_categories (model);
+    if (categories->len == 0)
+        return FALSE;
+
+    for (guint i = 0; i < categories->len; i++) {
+        StoreCategory *category = g_ptr_array_index (categories, i);
+        if (store_category_get_apps (category)->len == 0)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+timeout_cb (gpointer user_data)
+{
+    gboolean *timed_out = user_data;
+    *timed_out = TRUE;
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+wait_for_category_apps (StoreModel *model, GError **error)
+{
+    gboolean timed_out = FALSE;
+    g_autoptr(GSource) timeout_source = g_timeout_source_new_seconds (CATEGORY_APPS_TIMEOUT);
+    g_source_set_callback (timeout_source, timeout_cb, &timed_out, NULL);
+    g_source_attach (timeout_source, g_main_context_default ());
+
+    while (!categories_loaded (model) && !timed_out)
+        g_main_context_iteration (NULL, TRUE);
+    g_source_destroy (timeout_source);
+
+    if (timed_out) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT, "Timed out waiting for category apps");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+run_iteration (const gchar *socket_path, const gchar *odrs_uri, const gchar *media_uri, gint iteration, GError **error)
+{
+    /* Use a new model each time so nothing is considered fresh */
+    g_autoptr(StoreModel) model = store_model_new ();
+    store_model_set_cache (model, NULL);
+    store_model_set_snapd_socket_path (model, socket_path);
+    store_model_set_odrs_server_uri (model, odrs_uri);
+
+    g_autoptr(GAsyncResult) categories_result = NULL;
+    begin_operation ();
+    store_model_update_categories_async (model, NULL, result_cb, &categories_result);
+    wait_for_result (&categories_result);
+    if (!store_model_update_categories_finish (model, categories_result, error))
+        return FALSE;
+    if (!wait_for_category_apps (model, error))
+        return FALSE;
+    end_operation (OPERATION_CATEGORY_REFRESH);
+
+    g_autoptr(GAsyncResult) search_result = NULL;
+    begin_operation ();
+    store_model_search_async (model, mock_catalogue_get_keyword (iteration), NULL, result_cb, &search_result);
+    wait_for_result (&search_result);
+    g_autoptr(GPtrArray) apps = store_model_search_finish (model, search_result, error);
+    if (apps == NULL)
+        return FALSE;
+    end_operation (OPERATION_SEARCH);
+
+    g_autoptr(GAsyncResult) installed_result = NULL;
+    begin_operation ();
+    store_model_update_installed_async (model, NULL, result_cb, &installed_result);
+    wait_for_result (&installed_result);
+    if (!store_model_update_installed_finish (model, installed_result, error))
+        return FALSE;
+    end_operation (OPERATION_INSTALLED_REFRESH);
+
+    g_autoptr(GAsyncResult) ratings_result = NULL;
+    begin_operation ();
+    store_model_update_ratings_async (model, NULL, result_cb, &ratings_result);
+    wait_for_result (&ratings_result);
+    if (!store_model_update_ratings_finish (model, ratings_result, error))
+        return FALSE;
+    end_operation (OPERATION_RATINGS_UPDATE);
+
+    for (guint i = 0; i < apps->len && i < REVIEWS_PER_ITERATION; i++) {
+        StoreApp *app = g_ptr_array_index (apps, i);
+
+        g_autoptr(GAsyncResult) reviews_result = NULL;
+        begin_operation ();
+        store_model_update_reviews_async (model, app, NULL, result_cb, &reviews_result);
+        wait_for_result (&reviews_result);
+        if (!store_model_update_reviews_finish (model, reviews_result, error))
+            return FALSE;
+        end_operation (OPERATION_REVIEWS);
+    }
+
+    for (guint i = 0; i < apps->len && i < IMAGES_PER_ITERATION; i++) {
+        StoreApp *app = g_ptr_array_index (apps, i);
+        g_autofree gchar *uri = g_strdup_printf ("%s/icon/%s.png", media_uri, store_app_get_name (app));
+
+        g_autoptr(GAsyncResult) image_result = NULL;
+        begin_operation ();
+        store_model_get_image_async (model, uri, NULL, 64, 64, NULL, result_cb, &image_result);
+        wait_for_result (&image_result);
+        g_autoptr(GdkPixbuf) pixbuf = store_model_get_image_finish (model, image_result, error);
+        if (pixbuf == NULL)
+            return FALSE;
+        end_operation (OPERATION_IMAGE_FETCH);
+    }
+
+    return TRUE;
+}
+
+static gint
+compare_times (gconstpointer a, gconstpointer b)
+{
+    gint64 time_a = *((const gint64 *) a), time_b = *((const gint64 *) b);
+    return time_a < time_b ? -1 : time_a > time_b ? 1 : 0;
+}
+
+/* Nearest-rank percentile of sorted @times in milliseconds */
+static gdouble
+get_percentile (GArray *times, guint percentile)
+{
+    guint rank = (times->len * percentile + 99) / 100;
+    return g_array_index (times, gint64, MAX (rank, 1) - 1) / 1000.0;
+}
+
+static glong
+get_peak_rss (void)
+{
+    struct rusage usage;
+    if (getrusage (RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return usage.ru_maxrss;
+}
+
+int
+main (int argc, char **argv)
+{
+    const GOptionEntry entries[] =
+    {
+        { "snaps", 0, 0, G_OPTION_ARG_INT, &n_snaps, "Number of snaps in the store", "N" },
+        { "sections", 0, 0, G_OPTION_ARG_INT, &n_sections, "Number of store sections", "N" },
+        { "installed", 0, 0, G_OPTION_ARG_INT, &n_installed, "Number of installed snaps", "N" },
+        { "iterations", 0, 0, G_OPTION_ARG_INT, &n_iterations, "Number of times to run each operation", "N" },
+        { "rated-apps", 0, 0, G_OPTION_ARG_INT, &n_rated_apps, "Number of apps in the ratings from ODRS", "N" },
+        { "snapd-delay", 0, 0, G_OPTION_ARG_INT, &snapd_delay, "Delay in milliseconds before snapd responds to find, sections and snaps requests", "MS" },
+        { "snapd-bandwidth", 0, 0, G_OPTION_ARG_INT, &snapd_bandwidth, "Bytes per second snapd sends find, sections and snaps responses at", "BYTES" },
+        { "odrs-delay", 0, 0, G_OPTION_ARG_INT, &odrs_delay, "Delay in milliseconds before ODRS responds", "MS" },
+        { "odrs-bandwidth", 0, 0, G_OPTION_ARG_INT, &odrs_bandwidth, "Bytes per second ODRS sends responses at", "BYTES" },
+        { NULL }
+    };
+    g_autoptr(GOptionContext) context = g_option_context_new ("- benchmark StoreModel");
+    g_option_context_add_main_entries (context, entries, NULL);
+    g_autoptr(GError) error = NULL;
+    if (!g_option_context_parse (context, &argc, &argv, &error)) {
+        g_printerr ("%s\n", error->message);
+        return EXIT_FAILURE;
+    }
+    if (n_snaps <= 0 || n_sections <= 0 || n_installed < 0 || n_iterations <= 0 || snapd_delay < 0 || snapd_bandwidth < 0 || odrs_delay < 0 || odrs_bandwidth < 0) {
+        g_printerr ("Invalid catalogue size\n");
+        return EXIT_FAILURE;
+    }
+    /* Every section needs at least one snap for the categories to finish loading */
+    if (n_snaps < n_sections) {
+        g_printerr ("There must be at least as many snaps as sections\n");
+        return EXIT_FAILURE;
+    }
+
+    HttpServers servers = { 0 };
+    g_mutex_init (&servers.mutex);
+    g_cond_init (&servers.condition);
+    GThread *thread = g_thread_new ("http", http_thread, &servers);
+    g_mutex_lock (&servers.mutex);
+    while (!servers.started)
+        g_cond_wait (&servers.condition, &servers.mutex);
+    g_mutex_unlock (&servers.mutex);
+    if (servers.error != NULL) {
+        g_printerr ("Failed to start HTTP servers: %s\n", servers.error->message);
+        return EXIT_FAILURE;
+    }
+
+    g_autoptr(MockSnapd) snapd = mock_snapd_new ();
+    g_autofree gchar *media_uri = g_strdup_printf ("http://127.0.0.1:%u", servers.image_port);
+    mock_snapd_generate_catalogue (snapd, n_snaps, n_sections, n_installed, media_uri);
+    mock_snapd_set_endpoint_throttle (snapd, "/v2/find", snapd_delay, snapd_bandwidth);
+    mock_snapd_set_endpoint_throttle (snapd, "/v2/sections", snapd_delay, snapd_bandwidth);
+    mock_snapd_set_endpoint_throttle (snapd, "/v2/snaps", snapd_delay, snapd_bandwidth);
+    if (!mock_snapd_start (snapd, &error)) {
+        g_printerr ("Failed to start mock snapd: %s\n", error->message);
+        return EXIT_FAILURE;
+    }
+
+    g_autofree gchar *odrs_uri = g_strdup_printf ("http://127.0.0.1:%u", servers.odrs_port);
+    g_print ("Catalogue: %d snaps in %d sections, %d installed, %d rated\n", n_snaps, n_sections, n_installed, MAX (n_rated_apps, n_snaps));
+    glong setup_rss = get_peak_rss ();
+
+    for (int i = 0; i < OPERATION_LAST; i++)
+        measurements[i].times = g_array_new (FALSE, FALSE, sizeof (gint64));
+
+    count_allocations = TRUE;
+    for (gint i = 0; i < n_iterations; i++) {
+        if (!run_iteration (mock_snapd_get_socket_path (snapd), odrs_uri, media_uri, i, &error)) {
+            g_printerr ("Iteration %d failed: %s\n", i, error->message);
+            return EXIT_FAILURE;
+        }
+    }
+    count_allocations = FALSE;
+
+    g_print ("%-20s %6s %10s %10s %10s %10s %12s\n", "operation", "runs", "p50 (ms)", "p90 (ms)", "p99 (ms)", "max (ms)", "allocs/run");
+    for (int i = 0; i < OPERATION_LAST; i++) {
+        GArray *times = measurements[i].times;
+        if (times->len == 0)
+            continue;
+        g_array_sort (times, compare_times);
+        g_print ("%-20s %6u %10.2f %10.2f %10.2f %10.2f %12" G_GUINT64_FORMAT "\n",
+                 operation_names[i], times->len,
+                 get_percentile (times, 50), get_percentile (times, 90), get_percentile (times, 99), get_percentile (times, 100),
+                 measurements[i].allocations / times->len);
+        g_array_unref (times);
+    }
+#ifndef __GLIBC__
+    g_print ("Allocation counts are only available with glibc\n");
+#endif
+    g_print ("Peak RSS: %ld KiB (%ld KiB after starting the mock servers)\n", get_peak_rss (), setup_rss);
+
+    mock_snapd_stop (snapd);
+    g_main_context_invoke (g_main_loop_get_context (servers.loop), quit_cb, servers.loop);
+    g_thread_join (thread);
+    g_main_loop_unref (servers.loop);
+
+    return EXIT_SUCCESS;
+}
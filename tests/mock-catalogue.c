@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "mock-catalogue.h"
+
+/* Snap names start with one of these so searches return a known fraction of the catalogue */
+static const gchar *keywords[] = { "browser", "chat", "editor", "game", "music", "notes", "photo", "terminal", "video", "weather" };
+
+const gchar *
+mock_catalogue_get_keyword (guint index)
+{
+    return keywords[index % G_N_ELEMENTS (keywords)];
+}
+
+guint
+mock_catalogue_get_n_keywords (void)
+{
+    return G_N_ELEMENTS (keywords);
+}
+
+gchar *
+mock_catalogue_get_snap_name (guint index)
+{
+    return g_strdup_printf ("%s-%05u", mock_catalogue_get_keyword (index), index);
+}
+
+gchar *
+mock_catalogue_get_snap_id (guint index)
+{
+    return g_strdup_printf ("%032u", index);
+}
+
+/* Matches the ID StoreSnapApp gives snaps */
+gchar *
+mock_catalogue_get_appstream_id (guint index)
+{
+    g_autofree gchar *name = mock_catalogue_get_snap_name (index);
+    g_autofree gchar *id = mock_catalogue_get_snap_id (index);
+    return g_strdup_printf ("io.snapcraft.%s-%s", name, id);
+}
+
+gchar *
+mock_catalogue_get_section_name (guint index)
+{
+    return g_strdup_printf ("section-%02u", index);
+}
+
+gchar *
+mock_catalogue_make_text (gsize length)
+{
+    const gchar *lorem = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. ";
+    GString *text = g_string_sized_new (length);
+    while (text->len < length)
+        g_string_append (text, lorem);
+    g_string_truncate (text, length);
+    return g_string_free (text, FALSE);
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Names used by the generated catalogues in mock-snapd and mock-odrs, so the two match up */
+
+const gchar *mock_catalogue_get_keyword      (guint index);
+
+guint        mock_catalogue_get_n_keywords   (void);
+
+gchar       *mock_catalogue_get_snap_name    (guint index);
+
+gchar       *mock_catalogue_get_snap_id      (guint index);
+
+gchar       *mock_catalogue_get_appstream_id (guint index);
+
+gchar       *mock_catalogue_get_section_name (guint index);
+
+gchar       *mock_catalogue_make_text        (gsize length);
+
+G_END_DECLS
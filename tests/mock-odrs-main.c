@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdlib.h>
+
+#include "mock-odrs-server.h"
+
+static gint n_apps = 0;
+static gint max_reviews = 100;
+static gint delay = 0;
+static gint bandwidth = 0;
+static gboolean chunked = FALSE;
+
+static const GOptionEntry entries[] =
+{
+    { "apps", 0, 0, G_OPTION_ARG_INT, &n_apps, "Number of apps to generate ratings and reviews for", "N" },
+    { "reviews", 0, 0, G_OPTION_ARG_INT, &max_reviews, "Most reviews to generate for an app", "N" },
+    { "delay", 0, 0, G_OPTION_ARG_INT, &delay, "Delay in milliseconds before responding", "MS" },
+    { "bandwidth", 0, 0, G_OPTION_ARG_INT, &bandwidth, "Bytes per second to send responses at", "BYTES" },
+    { "chunked", 0, 0, G_OPTION_ARG_NONE, &chunked, "Use chunked transfer encoding", NULL },
+    { NULL }
+};
+
+int
+main (int argc, char **argv)
+{
+    g_autoptr(GOptionContext) context = g_option_context_new ("[PORT] - mock ODRS server");
+    g_option_context_add_main_entries (context, entries, NULL);
+    g_autoptr(GError) error = NULL;
+    if (!g_option_context_parse (context, &argc, &argv, &error)) {
+        g_printerr ("%s\n", error->message);
+        return EXIT_FAILURE;
+    }
+    if (n_apps < 0 || max_reviews < 0 || delay < 0 || bandwidth < 0) {
+        g_printerr ("Invalid option value\n");
+        return EXIT_FAILURE;
+    }
+
+    g_autoptr(GMainLoop) loop = g_main_loop_new (NULL, FALSE);
+
+    guint port = 0;
+    if (argc > 1)
+        port = atoi (argv[1]);
+
+    g_autoptr(MockOdrsServer) server = mock_odrs_server_new ();
+    mock_odrs_server_set_port (server, port);
+    mock_odrs_server_generate_apps (server, n_apps, max_reviews);
+    mock_odrs_server_set_delay (server, delay);
+    mock_odrs_server_set_bandwidth (server, bandwidth);
+    mock_odrs_server_set_chunked (server, chunked);
+    if (!mock_odrs_server_start (server, &error)) {
+        g_printerr ("Failed to start server: %s\n", error->message);
+        return EXIT_FAILURE;
+    }
+    g_printerr ("Listening on port %u\n", mock_odrs_server_get_port (server));
+
+    g_main_loop_run (loop);
+
+    return EXIT_SUCCESS;
+}
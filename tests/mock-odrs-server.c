@@ -8,14 +8,21 @@
  */
 
 #include <json-glib/json-glib.h>
+#include <string.h>
 
+#include "mock-catalogue.h"
 #include "mock-odrs-server.h"
+#include "mock-throttle.h"
 
 struct _MockOdrsServer
 {
     SoupServer parent_instance;
 
     GPtrArray *apps;
+    GHashTable *apps_by_id;
+    guint bytes_per_second;
+    gboolean chunked;
+    guint delay;
     guint port;
 };
 
@@ -60,6 +67,7 @@ struct _MockApp
 {
     gchar *id;
     GPtrArray *reviews;
+    gint64 star_counts[6];
 };
 
 static MockApp *
@@ -91,6 +99,14 @@ calculate_user_skey (const gchar *user_hash)
     return g_strdup (user_hash); // FIXME
 }
 
+/* Simulate a slow or distant server */
+static void
+throttle_response (MockOdrsServer *self, SoupMessage *msg)
+{
+    if (self->delay > 0 || self->bytes_per_second > 0 || self->chunked)
+        mock_throttle_response (SOUP_SERVER (self), msg, self->delay, self->bytes_per_second);
+}
+
 static void
 ratings_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *path G_GNUC_UNUSED, GHashTable *query G_GNUC_UNUSED, SoupClientContext *context G_GNUC_UNUSED, gpointer user_data)
 {
@@ -106,7 +122,8 @@ ratings_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *pat
     for (guint i = 0; i < self->apps->len; i++) {
         MockApp *app = g_ptr_array_index (self->apps, i);
 
-        gint64 count0, count1, count2 = 0, count3 = 0, count4 = 0, count5 = 0;
+        gint64 count0 = app->star_counts[0], count1 = app->star_counts[1], count2 = app->star_counts[2];
+        gint64 count3 = app->star_counts[3], count4 = app->star_counts[4], count5 = app->star_counts[5];
         for (guint j = 0; j < app->reviews->len; j++) {
             MockReview *review = g_ptr_array_index (app->reviews, j);
             if (review->rating == 0)
@@ -149,8 +166,21 @@ ratings_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *pat
     gsize json_text_length;
     g_autofree gchar *json_text = json_generator_to_data (generator, &json_text_length);
 
+    /* Support conditional requests */
+    g_autofree gchar *checksum = g_compute_checksum_for_data (G_CHECKSUM_SHA1, (const guchar *) json_text, json_text_length);
+    g_autofree gchar *etag = g_strdup_printf ("\"%s\"", checksum);
+    soup_message_headers_replace (msg->response_headers, "ETag", etag);
+    if (g_strcmp0 (soup_message_headers_get_one (msg->request_headers, "If-None-Match"), etag) == 0) {
+        /* There's no body to send, so only the delay applies */
+        soup_message_set_status (msg, SOUP_STATUS_NOT_MODIFIED);
+        if (self->delay > 0)
+            mock_throttle_response (SOUP_SERVER (self), msg, self->delay, 0);
+        return;
+    }
+
     soup_message_set_status (msg, SOUP_STATUS_OK);
     soup_message_set_response (msg, "application/json; charset=utf-8", SOUP_MEMORY_TAKE, g_steal_pointer (&json_text), json_text_length);
+    throttle_response (self, msg);
 }
 
 static JsonNode *
@@ -234,6 +264,9 @@ fetch_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *path
     const gchar *app_id = json_object_get_string_member (object, "app_id");
     //if (json_object_has_member (object, "compat_ids"))
     //    json_object_get_array_member (object, "compat_ids");
+    gint64 start = 0;
+    if (json_object_has_member (object, "start"))
+        start = json_object_get_int_member (object, "start");
     gint64 limit = G_MAXINT64;
     if (json_object_has_member (object, "limit"))
         limit = json_object_get_int_member (object, "limit");
@@ -244,7 +277,7 @@ fetch_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *path
 
     g_autoptr(JsonBuilder) builder = json_builder_new ();
     json_builder_begin_array (builder);
-    for (guint i = 0; app != NULL && i < app->reviews->len && i < limit; i++) {
+    for (guint i = MAX (start, 0); app != NULL && i < app->reviews->len && i - start < limit; i++) {
         MockReview *review = g_ptr_array_index (app->reviews, i);
         json_builder_begin_object (builder);
         json_builder_set_member_name (builder, "user_skey");
@@ -279,6 +312,7 @@ fetch_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *path
 
     soup_message_set_status (msg, SOUP_STATUS_OK);
     soup_message_set_response (msg, "application/json; charset=utf-8", SOUP_MEMORY_TAKE, g_steal_pointer (&json_text), json_text_length);
+    throttle_response (self, msg);
 }
 
 static void
@@ -394,13 +428,13 @@ feedback_cb (SoupServer *server G_GNUC_UNUSED, SoupMessage *msg, const gchar *pa
         return;
     }
 
-    if (g_strcmp0 (path, "/upvote") == 0) {
+    if (g_strcmp0 (path, "/1.0/reviews/api/upvote") == 0) {
         review->upvote_count++;
     }
-    else if (g_strcmp0 (path, "/downvote") == 0) {
+    else if (g_strcmp0 (path, "/1.0/reviews/api/downvote") == 0) {
         review->downvote_count++;
     }
-    else if (g_strcmp0 (path, "/report") == 0) {
+    else if (g_strcmp0 (path, "/1.0/reviews/api/report") == 0) {
         review->report_count++;
     }
 
@@ -412,6 +446,7 @@ mock_odrs_server_dispose (GObject *object)
 {
     MockOdrsServer *self = MOCK_ODRS_SERVER (object);
 
+    g_clear_pointer (&self->apps_by_id, g_hash_table_unref);
     g_clear_pointer (&self->apps, g_ptr_array_unref);
 
     G_OBJECT_CLASS (mock_odrs_server_parent_class)->dispose (object);
@@ -427,14 +462,15 @@ static void
 mock_odrs_server_init (MockOdrsServer *self)
 {
     self->apps = g_ptr_array_new_with_free_func ((GDestroyNotify) mock_app_free);
+    self->apps_by_id = g_hash_table_new (g_str_hash, g_str_equal);
 
     g_object_set (self, "server-header", "mock-odrs", NULL);
-    soup_server_add_handler (SOUP_SERVER (self), "/ratings", ratings_cb, self, NULL);
-    soup_server_add_handler (SOUP_SERVER (self), "/fetch", fetch_cb, self, NULL);
-    soup_server_add_handler (SOUP_SERVER (self), "/submit", submit_cb, self, NULL);
-    soup_server_add_handler (SOUP_SERVER (self), "/upvote", feedback_cb, self, NULL);
-    soup_server_add_handler (SOUP_SERVER (self), "/downvote", feedback_cb, self, NULL);
-    soup_server_add_handler (SOUP_SERVER (self), "/report", feedback_cb, self, NULL);
+    soup_server_add_handler (SOUP_SERVER (self), "/1.0/reviews/api/ratings", ratings_cb, self, NULL);
+    soup_server_add_handler (SOUP_SERVER (self), "/1.0/reviews/api/fetch", fetch_cb, self, NULL);
+    soup_server_add_handler (SOUP_SERVER (self), "/1.0/reviews/api/submit", submit_cb, self, NULL);
+    soup_server_add_handler (SOUP_SERVER (self), "/1.0/reviews/api/upvote", feedback_cb, self, NULL);
+    soup_server_add_handler (SOUP_SERVER (self), "/1.0/reviews/api/downvote", feedback_cb, self, NULL);
+    soup_server_add_handler (SOUP_SERVER (self), "/1.0/reviews/api/report", feedback_cb, self, NULL);
 }
 
 MockOdrsServer *
@@ -480,6 +516,70 @@ mock_odrs_server_start (MockOdrsServer *self, GError **error)
     return soup_server_listen_local (SOUP_SERVER (self), self->port, 0, error);
 }
 
+/* Delays ratings and reviews responses by @delay milliseconds */
+void
+mock_odrs_server_set_delay (MockOdrsServer *self, guint delay)
+{
+    g_return_if_fail (MOCK_IS_ODRS_SERVER (self));
+
+    self->delay = delay;
+}
+
+/* Sends ratings and reviews responses at @bytes_per_second, or 0 for unlimited */
+void
+mock_odrs_server_set_bandwidth (MockOdrsServer *self, guint bytes_per_second)
+{
+    g_return_if_fail (MOCK_IS_ODRS_SERVER (self));
+
+    self->bytes_per_second = bytes_per_second;
+}
+
+/* Sends ratings and reviews responses with chunked transfer encoding. Delayed and throttled responses are always chunked */
+void
+mock_odrs_server_set_chunked (MockOdrsServer *self, gboolean chunked)
+{
+    g_return_if_fail (MOCK_IS_ODRS_SERVER (self));
+
+    self->chunked = chunked;
+}
+
+/* Adds @n_apps apps with the IDs of the snaps in mock-snapd's generated catalogue.
+ * Every app has ratings, and up to @max_reviews reviews to fetch, with a few apps having many */
+void
+mock_odrs_server_generate_apps (MockOdrsServer *self, guint n_apps, guint max_reviews)
+{
+    g_return_if_fail (MOCK_IS_ODRS_SERVER (self));
+
+    g_autofree gchar *text = mock_catalogue_make_text (1000);
+    gsize text_length = strlen (text);
+    gint64 review_id = 1;
+
+    for (guint i = 0; i < n_apps; i++) {
+        g_autofree gchar *id = mock_catalogue_get_appstream_id (i);
+        MockApp *app = mock_odrs_server_add_app (self, id);
+
+        /* Most apps have a handful of ratings and a few popular ones have thousands */
+        guint scale = i % 100 == 0 ? 1000 : i % 10 == 0 ? 100 : 5;
+        for (guint star = 1; star <= 5; star++)
+            app->star_counts[star] = (i * 7 + star * 13) % (scale * star + 1);
+
+        guint n_reviews = i % 100 == 0 ? max_reviews : MIN (i % 5, max_reviews);
+        for (guint j = 0; j < n_reviews; j++) {
+            MockReview *review = mock_app_add_review (app);
+            review->id = review_id++;
+            review->rating = (i + j) % 5 + 1;
+            review->locale = g_strdup ("en_US");
+            review->distro = g_strdup ("Ubuntu");
+            review->version = g_strdup ("1.0");
+            review->user_display = g_strdup_printf ("User %u", (i + j) % 10000);
+            review->date_created = 1546300800 + (i + j) * 3600;
+            review->summary = g_strdup_printf ("Review %u of %s", j, id);
+            /* Reviews vary from a sentence to a few paragraphs */
+            review->description = g_strdup (text + (i * 31 + j * 97) % (text_length - 50));
+        }
+    }
+}
+
 MockApp *
 mock_odrs_server_add_app (MockOdrsServer *self, const gchar *id)
 {
@@ -489,6 +589,7 @@ mock_odrs_server_add_app (MockOdrsServer *self, const gchar *id)
     if (app == NULL) {
         app = mock_app_new (id);
         g_ptr_array_add (self->apps, app);
+        g_hash_table_insert (self->apps_by_id, app->id, app);
     }
 
     return app;
@@ -499,13 +600,10 @@ mock_odrs_server_find_app (MockOdrsServer *self, const gchar *id)
 {
     g_return_val_if_fail (MOCK_IS_ODRS_SERVER (self), NULL);
 
-    for (guint i = 0; i < self->apps->len; i++) {
-        MockApp *app = g_ptr_array_index (self->apps, i);
-        if (g_strcmp0 (app->id, id) == 0)
-            return app;
-    }
+    if (id == NULL)
+        return NULL;
 
-    return NULL;
+    return g_hash_table_lookup (self->apps_by_id, id);
 }
 
 MockReview *
@@ -581,26 +679,3 @@ mock_review_set_rating (MockReview *review, gint64 rating)
 {
     review->rating = rating;
 }
-
-int
-main (int argc, char **argv)
-{
-    g_autoptr(GMainLoop) loop = g_main_loop_new (NULL, FALSE);
-
-    guint port = 0;
-    if (argc > 1)
-        port = atoi (argv[1]);
-
-    g_autoptr(MockOdrsServer) server = mock_odrs_server_new ();
-    mock_odrs_server_set_port (server, port);
-    g_autoptr(GError) error = NULL;
-    if (!mock_odrs_server_start (server, &error)) {
-        g_printerr ("Failed to start server: %s\n", error->message);
-        return EXIT_FAILURE;
-    }
-    g_printerr ("Listening on port %u\n", mock_odrs_server_get_port (server));
-
-    g_main_loop_run (loop);
-
-    return EXIT_SUCCESS;
-}
@@ -18,34 +18,44 @@ G_DECLARE_FINAL_TYPE (MockOdrsServer, mock_odrs_server, MOCK, ODRS_SERVER, SoupS
 typedef struct _MockApp MockApp;
 typedef struct _MockReview MockReview;
 
-MockOdrsServer *mock_odrs_server_new         (void);
+MockOdrsServer *mock_odrs_server_new           (void);
 
-void            mock_odrs_server_set_port    (MockOdrsServer *server, guint port);
+void            mock_odrs_server_set_port      (MockOdrsServer *server, guint port);
 
-guint           mock_odrs_server_get_port    (MockOdrsServer *server);
+guint           mock_odrs_server_get_port      (MockOdrsServer *server);
 
-MockApp        *mock_odrs_server_add_app     (MockOdrsServer *server, const gchar *id);
+gboolean        mock_odrs_server_start         (MockOdrsServer *server, GError **error);
 
-MockApp        *mock_odrs_server_find_app    (MockOdrsServer *server, const gchar *id);
+void            mock_odrs_server_set_delay     (MockOdrsServer *server, guint delay);
 
-MockReview     *mock_app_add_review          (MockApp *app);
+void            mock_odrs_server_set_bandwidth (MockOdrsServer *server, guint bytes_per_second);
 
-MockReview     *mock_app_find_review         (MockApp *app, gint64 id);
+void            mock_odrs_server_set_chunked   (MockOdrsServer *server, gboolean chunked);
 
-void            mock_review_set_locale       (MockReview *review, const gchar *locale);
+void            mock_odrs_server_generate_apps (MockOdrsServer *server, guint n_apps, guint max_reviews);
 
-void            mock_review_set_distro       (MockReview *review, const gchar *distro);
+MockApp        *mock_odrs_server_add_app       (MockOdrsServer *server, const gchar *id);
 
-void            mock_review_set_version      (MockReview *review, const gchar *version);
+MockApp        *mock_odrs_server_find_app      (MockOdrsServer *server, const gchar *id);
 
-void            mock_review_set_date_created (MockReview *review, gint64 date_created);
+MockReview     *mock_app_add_review            (MockApp *app);
 
-void            mock_review_set_user_display (MockReview *review, const gchar *user_display);
+MockReview     *mock_app_find_review           (MockApp *app, gint64 id);
 
-void            mock_review_set_summary      (MockReview *review, const gchar *summary);
+void            mock_review_set_locale         (MockReview *review, const gchar *locale);
 
-void            mock_review_set_description  (MockReview *review, const gchar *description);
+void            mock_review_set_distro         (MockReview *review, const gchar *distro);
 
-void            mock_review_set_rating       (MockReview *review, gint64 rating);
+void            mock_review_set_version        (MockReview *review, const gchar *version);
+
+void            mock_review_set_date_created   (MockReview *review, gint64 date_created);
+
+void            mock_review_set_user_display   (MockReview *review, const gchar *user_display);
+
+void            mock_review_set_summary        (MockReview *review, const gchar *summary);
+
+void            mock_review_set_description    (MockReview *review, const gchar *description);
+
+void            mock_review_set_rating         (MockReview *review, gint64 rating);
 
 G_END_DECLS
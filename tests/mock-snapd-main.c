@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdlib.h>
+
+#include "mock-snapd.h"
+
+static gint n_snaps = 0;
+static gint n_sections = 20;
+static gint n_installed = 0;
+static gchar *media_uri = NULL;
+static gint find_delay = 0;
+static gint find_bandwidth = 0;
+static gint sections_delay = 0;
+static gint sections_bandwidth = 0;
+static gint snaps_delay = 0;
+static gint snaps_bandwidth = 0;
+
+static const GOptionEntry entries[] =
+{
+    { "snaps", 0, 0, G_OPTION_ARG_INT, &n_snaps, "Number of snaps to generate in the store", "N" },
+    { "sections", 0, 0, G_OPTION_ARG_INT, &n_sections, "Number of store sections to put them in", "N" },
+    { "installed", 0, 0, G_OPTION_ARG_INT, &n_installed, "Number of the generated snaps to install", "N" },
+    { "media-uri", 0, 0, G_OPTION_ARG_STRING, &media_uri, "Server to use in icon and screenshot URLs", "URI" },
+    { "find-delay", 0, 0, G_OPTION_ARG_INT, &find_delay, "Delay in milliseconds before responding to /v2/find", "MS" },
+    { "find-bandwidth", 0, 0, G_OPTION_ARG_INT, &find_bandwidth, "Bytes per second to send /v2/find responses at", "BYTES" },
+    { "sections-delay", 0, 0, G_OPTION_ARG_INT, &sections_delay, "Delay in milliseconds before responding to /v2/sections", "MS" },
+    { "sections-bandwidth", 0, 0, G_OPTION_ARG_INT, &sections_bandwidth, "Bytes per second to send /v2/sections responses at", "BYTES" },
+    { "snaps-delay", 0, 0, G_OPTION_ARG_INT, &snaps_delay, "Delay in milliseconds before responding to /v2/snaps", "MS" },
+    { "snaps-bandwidth", 0, 0, G_OPTION_ARG_INT, &snaps_bandwidth, "Bytes per second to send /v2/snaps responses at", "BYTES" },
+    { NULL }
+};
+
+int
+main (int argc, char **argv)
+{
+    g_autoptr(GOptionContext) context = g_option_context_new ("- mock snapd");
+    g_option_context_add_main_entries (context, entries, NULL);
+    g_autoptr(GError) error = NULL;
+    if (!g_option_context_parse (context, &argc, &argv, &error)) {
+        g_printerr ("%s\n", error->message);
+        return EXIT_FAILURE;
+    }
+    if (n_snaps < 0 || n_sections <= 0 || n_installed < 0 ||
+        find_delay < 0 || find_bandwidth < 0 || sections_delay < 0 || sections_bandwidth < 0 || snaps_delay < 0 || snaps_bandwidth < 0) {
+        g_printerr ("Invalid option value\n");
+        return EXIT_FAILURE;
+    }
+
+    g_autoptr(GMainLoop) loop = g_main_loop_new (NULL, FALSE);
+
+    g_autoptr(MockSnapd) server = mock_snapd_new ();
+    if (n_snaps > 0)
+        mock_snapd_generate_catalogue (server, n_snaps, n_sections, n_installed, media_uri);
+    mock_snapd_set_endpoint_throttle (server, "/v2/find", find_delay, find_bandwidth);
+    mock_snapd_set_endpoint_throttle (server, "/v2/sections", sections_delay, sections_bandwidth);
+    mock_snapd_set_endpoint_throttle (server, "/v2/snaps", snaps_delay, snaps_bandwidth);
+    if (!mock_snapd_start (server, &error)) {
+        g_printerr ("Failed to start server: %s\n", error->message);
+        return EXIT_FAILURE;
+    }
+    g_printerr ("Listening on socket %s\n", mock_snapd_get_socket_path (server));
+
+    g_main_loop_run (loop);
+
+    return EXIT_SUCCESS;
+}
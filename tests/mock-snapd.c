@@ -18,7 +18,9 @@
 #include <libsoup/soup.h>
 #include <json-glib/json-glib.h>
 
+#include "mock-catalogue.h"
 #include "mock-snapd.h"
+#include "mock-throttle.h"
 
 struct _MockSnapd
 {
@@ -61,10 +63,17 @@ struct _MockSnapd
     gchar *spawn_time;
     gchar *ready_time;
     SoupMessageHeaders *last_request_headers;
+    GHashTable *throttles;
 };
 
 G_DEFINE_TYPE (MockSnapd, mock_snapd, G_TYPE_OBJECT)
 
+typedef struct
+{
+    guint bytes_per_second;
+    guint delay;
+} EndpointThrottle;
+
 struct _MockApp
 {
     gchar *name;
@@ -700,6 +709,127 @@ mock_snapd_add_store_snap (MockSnapd *snapd, const gchar *name)
     return snap;
 }
 
+static MockSnap *
+generate_store_snap (guint index, guint n_sections, const gchar *media_uri, const gchar *description)
+{
+    g_autofree gchar *name = mock_catalogue_get_snap_name (index);
+    MockSnap *snap = mock_snap_new (name);
+
+    g_autofree gchar *id = mock_catalogue_get_snap_id (index);
+    mock_snap_set_id (snap, id);
+    g_autofree gchar *title = g_strdup_printf ("%s %u", mock_catalogue_get_keyword (index), index);
+    title[0] = g_ascii_toupper (title[0]);
+    mock_snap_set_title (snap, title);
+    g_autofree gchar *summary = g_strdup_printf ("A %s that does everything you need, number %u in the catalogue", mock_catalogue_get_keyword (index), index);
+    mock_snap_set_summary (snap, summary);
+    /* Descriptions vary from a couple of sentences to a few paragraphs */
+    mock_snap_set_description (snap, description + (index * 7919) % (strlen (description) - 200));
+    g_autofree gchar *publisher_id = g_strdup_printf ("publisher-%u", index % 500);
+    mock_snap_set_publisher_id (snap, publisher_id);
+    mock_snap_set_publisher_username (snap, publisher_id);
+    g_autofree gchar *publisher_name = g_strdup_printf ("Publisher %u", index % 500);
+    mock_snap_set_publisher_display_name (snap, publisher_name);
+    if (index % 20 == 0)
+        mock_snap_set_publisher_validation (snap, "verified");
+    mock_snap_set_license (snap, index % 4 == 0 ? "MIT" : index % 4 == 1 ? "GPL-3.0" : index % 4 == 2 ? "Apache-2.0" : "Proprietary");
+    mock_snap_set_contact (snap, "https://example.com/contact");
+    g_autofree gchar *version = g_strdup_printf ("%u.%u.%u", index % 5, index % 17, index % 3);
+    mock_snap_set_version (snap, version);
+    g_autofree gchar *revision = g_strdup_printf ("%u", 1 + index % 2000);
+    mock_snap_set_revision (snap, revision);
+    snap->download_size = 1000000 + (index * 104729) % 200000000;
+
+    /* Every snap has all risks in latest, and some have an older track too */
+    MockTrack *track = mock_snap_add_track (snap, "latest");
+    const gchar *risks[] = { "stable", "candidate", "beta", "edge" };
+    for (guint i = 0; i < G_N_ELEMENTS (risks); i++) {
+        MockChannel *channel = mock_track_add_channel (track, risks[i], NULL);
+        g_autofree gchar *channel_revision = g_strdup_printf ("%u", 1 + index % 2000 + i);
+        mock_channel_set_revision (channel, channel_revision);
+        mock_channel_set_version (channel, version);
+        mock_channel_set_size (channel, snap->download_size);
+        mock_channel_set_released_at (channel, "2019-06-01T00:00:00.000000+00:00");
+    }
+    if (index % 10 == 0) {
+        MockTrack *old_track = mock_snap_add_track (snap, "1.0");
+        MockChannel *channel = mock_track_add_channel (old_track, "stable", NULL);
+        mock_channel_set_version (channel, "1.0");
+        mock_channel_set_released_at (channel, "2018-01-01T00:00:00.000000+00:00");
+    }
+
+    if (media_uri != NULL) {
+        g_autofree gchar *icon_url = g_strdup_printf ("%s/icon/%s.png", media_uri, name);
+        mock_snap_add_media (snap, "icon", icon_url, 256, 256);
+        for (guint i = 0; i < 1 + index % 5; i++) {
+            g_autofree gchar *screenshot_url = g_strdup_printf ("%s/screenshot/%s-%u.png", media_uri, name, i);
+            mock_snap_add_media (snap, "screenshot", screenshot_url, 1280, 720);
+        }
+    }
+
+    /* Every snap is in one section and some are in a second */
+    g_autofree gchar *section = mock_catalogue_get_section_name (index % n_sections);
+    mock_snap_add_store_section (snap, section);
+    guint other_section_index = (index / n_sections) % n_sections;
+    if (index % 3 == 0 && other_section_index != index % n_sections) {
+        g_autofree gchar *other_section = mock_catalogue_get_section_name (other_section_index);
+        mock_snap_add_store_section (snap, other_section);
+    }
+
+    return snap;
+}
+
+/* Fills the store with @n_snaps snaps across @n_sections sections, and installs @n_installed of them.
+ * Media is served from @media_uri if set, see mock-catalogue.h for the names used */
+void
+mock_snapd_generate_catalogue (MockSnapd *snapd, guint n_snaps, guint n_sections, guint n_installed, const gchar *media_uri)
+{
+    g_return_if_fail (MOCK_IS_SNAPD (snapd));
+    g_return_if_fail (n_sections > 0);
+
+    g_autofree gchar *description = mock_catalogue_make_text (3000);
+    GList *store_snaps = NULL;
+    for (guint i = 0; i < n_snaps; i++)
+        store_snaps = g_list_prepend (store_snaps, generate_store_snap (i, n_sections, media_uri, description));
+
+    /* Spread the installed snaps evenly across the store, each at most once */
+    n_installed = MIN (n_installed, n_snaps);
+    GList *snaps = NULL;
+    for (guint i = 0; i < n_installed; i++) {
+        guint index = (guint64) i * n_snaps / n_installed;
+        g_autofree gchar *name = mock_catalogue_get_snap_name (index);
+        MockSnap *snap = mock_snap_new (name);
+        g_autofree gchar *id = mock_catalogue_get_snap_id (index);
+        mock_snap_set_id (snap, id);
+        mock_snap_set_summary (snap, "An installed snap");
+        mock_snap_set_tracking_channel (snap, "latest/stable");
+        snaps = g_list_prepend (snaps, snap);
+    }
+
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new (&snapd->mutex);
+    snapd->store_snaps = g_list_concat (snapd->store_snaps, g_list_reverse (store_snaps));
+    snapd->snaps = g_list_concat (snapd->snaps, g_list_reverse (snaps));
+    for (guint i = 0; i < n_sections; i++)
+        snapd->store_sections = g_list_append (snapd->store_sections, mock_catalogue_get_section_name (i));
+}
+
+/* Delays responses to @path by @delay milliseconds, then sends them at @bytes_per_second (0 for unlimited) */
+void
+mock_snapd_set_endpoint_throttle (MockSnapd *snapd, const gchar *path, guint delay, guint bytes_per_second)
+{
+    g_return_if_fail (MOCK_IS_SNAPD (snapd));
+
+    g_autoptr(GMutexLocker) locker = g_mutex_locker_new (&snapd->mutex);
+    if (delay == 0 && bytes_per_second == 0) {
+        g_hash_table_remove (snapd->throttles, path);
+        return;
+    }
+
+    EndpointThrottle *throttle = g_new0 (EndpointThrottle, 1);
+    throttle->delay = delay;
+    throttle->bytes_per_second = bytes_per_second;
+    g_hash_table_insert (snapd->throttles, g_strdup (path), throttle);
+}
+
 static MockSnap *
 find_store_snap_by_name (MockSnapd *snapd, const gchar *name, const gchar *channel,  const gchar *revision)
 {
@@ -3303,7 +3433,7 @@ handle_sections (MockSnapd *snapd, SoupMessage *message)
 }
 
 static void
-handle_request (SoupServer *server G_GNUC_UNUSED, SoupMessage *message, const gchar *path, GHashTable *query, SoupClientContext *client, gpointer user_data)
+handle_request (SoupServer *server, SoupMessage *message, const gchar *path, GHashTable *query, SoupClientContext *client, gpointer user_data)
 {
     MockSnapd *snapd = MOCK_SNAPD (user_data);
 
@@ -3349,6 +3479,11 @@ handle_request (SoupServer *server G_GNUC_UNUSED, SoupMessage *message, const gc
         handle_sections (snapd, message);
     else
         send_error_not_found (snapd, message, "not found", NULL);
+
+    /* Simulate a slow connection to snapd or the store */
+    EndpointThrottle *throttle = g_hash_table_lookup (snapd->throttles, path);
+    if (throttle != NULL && message->status_code != SOUP_STATUS_NONE)
+        mock_throttle_response (server, message, throttle->delay, throttle->bytes_per_second);
 }
 
 static gboolean
@@ -3406,6 +3541,7 @@ mock_snapd_finalize (GObject *object)
     g_clear_pointer (&snapd->spawn_time, g_free);
     g_clear_pointer (&snapd->ready_time, g_free);
     g_clear_pointer (&snapd->last_request_headers, soup_message_headers_free);
+    g_clear_pointer (&snapd->throttles, g_hash_table_unref);
     g_clear_pointer (&snapd->context, g_main_context_unref);
     g_clear_pointer (&snapd->loop, g_main_loop_unref);
 
@@ -3543,6 +3679,7 @@ mock_snapd_init (MockSnapd *snapd)
     g_cond_init (&snapd->condition);
 
     snapd->sandbox_features = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+    snapd->throttles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
     g_autoptr(GError) error = NULL;
     snapd->dir_path = g_dir_make_tmp ("mock-snapd-XXXXXX", &error);
     if (snapd->dir_path == NULL)
@@ -3550,21 +3687,3 @@ mock_snapd_init (MockSnapd *snapd)
     g_clear_error (&error);
     snapd->socket_path = g_build_filename (snapd->dir_path, "snapd.socket", NULL);
 }
-
-int
-main (int argc G_GNUC_UNUSED, char **argv G_GNUC_UNUSED)
-{
-    g_autoptr(GMainLoop) loop = g_main_loop_new (NULL, FALSE);
-
-    g_autoptr(MockSnapd) server = mock_snapd_new ();
-    g_autoptr(GError) error = NULL;
-    if (!mock_snapd_start (server, &error)) {
-        g_printerr ("Failed to start server: %s\n", error->message);
-        return EXIT_FAILURE;
-    }
-    g_printerr ("Listening on socket %s\n", mock_snapd_get_socket_path (server));
-
-    g_main_loop_run (loop);
-
-    return EXIT_SUCCESS;
-}
@@ -110,6 +110,10 @@ void           mock_snapd_add_store_section          (MockSnapd *snapd, const gc
 
 MockSnap      *mock_snapd_add_store_snap             (MockSnapd *snapd, const gchar *name);
 
+void           mock_snapd_generate_catalogue         (MockSnapd *snapd, guint n_snaps, guint n_sections, guint n_installed, const gchar *media_uri);
+
+void           mock_snapd_set_endpoint_throttle      (MockSnapd *snapd, const gchar *path, guint delay, guint bytes_per_second);
+
 MockApp       *mock_snap_add_app                     (MockSnap *snap, const gchar *name);
 
 MockApp       *mock_snap_find_app                    (MockSnap *snap, const gchar *name);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "mock-throttle.h"
+
+/* Time in milliseconds between chunks when limiting bandwidth */
+#define CHUNK_INTERVAL 10
+
+typedef struct
+{
+    SoupBuffer *body;
+    guint bytes_per_second;
+    GMainContext *context;
+    gboolean has_body;
+    SoupMessage *message;
+    gsize offset;
+    SoupServer *server;
+    GSource *source;
+} ThrottledResponse;
+
+static void
+throttled_response_free (ThrottledResponse *response)
+{
+    if (response->source != NULL)
+        g_source_destroy (response->source);
+    g_clear_pointer (&response->source, g_source_unref);
+    soup_buffer_free (response->body);
+    g_main_context_unref (response->context);
+    g_object_unref (response->message);
+    g_object_unref (response->server);
+    g_free (response);
+}
+
+static gboolean
+send_chunk_cb (gpointer user_data)
+{
+    ThrottledResponse *response = user_data;
+
+    gsize length = response->body->length - response->offset;
+    if (response->bytes_per_second > 0)
+        length = MIN (length, MAX (response->bytes_per_second * CHUNK_INTERVAL / 1000, 1));
+    if (length > 0) {
+        SoupBuffer *chunk = soup_buffer_new_subbuffer (response->body, response->offset, length);
+        soup_message_body_append_buffer (response->message->response_body, chunk);
+        soup_buffer_free (chunk);
+        response->offset += length;
+    }
+
+    gboolean complete = response->offset >= response->body->length;
+    if (complete)
+        soup_message_body_complete (response->message->response_body);
+    soup_server_unpause_message (response->server, response->message);
+
+    return complete ? G_SOURCE_REMOVE : G_SOURCE_CONTINUE;
+}
+
+static gboolean
+delay_cb (gpointer user_data)
+{
+    ThrottledResponse *response = user_data;
+
+    g_clear_pointer (&response->source, g_source_unref);
+    if (!response->has_body) {
+        soup_server_unpause_message (response->server, response->message);
+        return G_SOURCE_REMOVE;
+    }
+    if (response->bytes_per_second == 0) {
+        send_chunk_cb (response);
+        return G_SOURCE_REMOVE;
+    }
+
+    response->source = g_timeout_source_new (CHUNK_INTERVAL);
+    g_source_set_callback (response->source, send_chunk_cb, response, NULL);
+    g_source_attach (response->source, response->context);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* Holds back the response already set on @message for @delay milliseconds, then sends it in chunks at @bytes_per_second
+ * (or all at once if 0). Responses that can't have a body, e.g. 304 Not Modified, are only delayed.
+ * Must be called from a server handler */
+void
+mock_throttle_response (SoupServer *server, SoupMessage *message, guint delay, guint bytes_per_second)
+{
+    ThrottledResponse *response = g_new0 (ThrottledResponse, 1);
+    response->body = soup_message_body_flatten (message->response_body);
+    response->bytes_per_second = bytes_per_second;
+    response->context = g_main_context_ref_thread_default ();
+    response->message = g_object_ref (message);
+    response->server = g_object_ref (server);
+
+    response->has_body = !SOUP_STATUS_IS_INFORMATIONAL (message->status_code) &&
+                         message->status_code != SOUP_STATUS_NO_CONTENT &&
+                         message->status_code != SOUP_STATUS_NOT_MODIFIED;
+    if (response->has_body) {
+        soup_message_body_truncate (message->response_body);
+        soup_message_headers_set_encoding (message->response_headers, SOUP_ENCODING_CHUNKED);
+    }
+    g_signal_connect_swapped (message, "finished", G_CALLBACK (throttled_response_free), response);
+
+    response->source = g_timeout_source_new (delay);
+    g_source_set_callback (response->source, delay_cb, response, NULL);
+    g_source_attach (response->source, response->context);
+
+    soup_server_pause_message (server, message);
+}